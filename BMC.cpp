@@ -73,33 +73,21 @@ void BMC::show_constraints(){
     cout << endl;
 }
 
-void BMC::encode_init_condition(SATSolver *s){
-    s->add(-1); s->add(0); 
+void BMC::encode_init_condition(CaDiCaL *s){
+    vector<int> cnf;
+    cnf.push_back(-1); cnf.push_back(0);
     for(int l : init_state){ 
         //cout << l << " "; l = -6 -7 -8 -9 -10 i.e. five initial latches
-        bmcSolver->add(l); bmcSolver->add(0);
+        cnf.push_back(l); cnf.push_back(0);
     }
 
     if(constraints.size() >= 0){
         for(int l : constraints){ //-5 -4 -3 i.e. three zero inputs 
-            s->add(l); s->add(0);}
-
-        set<int> lit_set;
-        for(int l : constraints)
-            lit_set.insert(abs(l));
-
-        for(auto i = ands.rbegin(); i != ands.rend(); ++i){
-            And & a = *i;
-            if(lit_set.find(a.o) == lit_set.end())
-                continue;
-            lit_set.insert(abs(a.i1));
-            lit_set.insert(abs(a.i2));//to be reveised
-            
-            s->add(-a.o); s->add(a.i1);  s->add(0);
-            s->add(-a.o); s->add(a.i2);  s->add(0);
-            s->add(a.o);  s->add(-a.i1); s->add(-a.i2); s->add(0);
-        }
+            cnf.push_back(l); cnf.push_back(0);}
+
+        Cone_encoder().encode(ands, constraints, cnf);
     }
+    s->add_cnf(cnf);
     int res = bmcSolver->solve();
     cout << "check init result = " << res << endl;
 }
@@ -128,17 +116,17 @@ void BMC::translate_to_dimacs(){
     // load latches
     nLatches = aiger->num_latches;
     for(int i=1; i<=nLatches; ++i){
-        assert((nInputs+i)*2 == aiger->latches[i-1].l);
+        assert((nInputs+i)*2 == aiger->latch_lit(i-1));
         variables.push_back(Variable(1 + nInputs + i, 'l', i-1, false));
     }
     
     // load ands
     nAnds = aiger->num_ands;
     for(int i=1; i<=nAnds; ++i){
-        assert(2*(nInputs+nLatches+i) == aiger->ands[i-1].o);
+        assert(2*(nInputs+nLatches+i) == aiger->and_lit(i-1));
         int o = 1+nInputs+nLatches+i;
-        int i1 = aiger_to_dimacs(aiger->ands[i-1].i1);
-        int i2 = aiger_to_dimacs(aiger->ands[i-1].i2);
+        int i1 = aiger_to_dimacs(aiger->and_i1[i-1]);
+        int i2 = aiger_to_dimacs(aiger->and_i2[i-1]);
         variables.push_back(Variable(o, 'a', i-1, false));
         ands.push_back(And(o, i1, i2));
     }
@@ -146,12 +134,12 @@ void BMC::translate_to_dimacs(){
     // deal with initial states
     for(int i=1; i<=nLatches; ++i){
         int l = 1 + nInputs + i;
-        assert((l-1)*2 == aiger->latches[i-1].l);
-        Aiger_latches & al = aiger->latches[i-1];
-        nexts.push_back(aiger_to_dimacs(al.next));
-        if(al.default_val==0){
+        assert((l-1)*2 == aiger->latch_lit(i-1));
+        unsigned default_val = aiger->latch_default[i-1];
+        nexts.push_back(aiger_to_dimacs(aiger->latch_next[i-1]));
+        if(default_val==0){
             init_state.push_back(-l);
-        }else if(al.default_val==1){
+        }else if(default_val==1){
             init_state.push_back(l);
         }
     }
@@ -391,15 +379,22 @@ void BMC::initialize(){
 //check all frames
 int BMC::check(){
     int res;
-    for(bmc_frame_k = 1; bmc_frame_k <= nframes; bmc_frame_k++){
-        unfold();
-        res = solve_one_frame();
-        if (res == 10) {
-            uaiger->show_statistics();
-            cout << "Output was asserted in frame." << endl;
-            return 1;
-        }   
-    } 
+    try{
+        for(bmc_frame_k = 1; bmc_frame_k <= nframes; bmc_frame_k++){
+            unfold();
+            res = solve_one_frame();
+            if (res == 10) {
+                uaiger->show_statistics();
+                cout << "Output was asserted in frame." << endl;
+                return 1;
+            }   
+        } 
+    }catch(Limit_reached &){
+        cout << endl << "c limits reached after " << get_runtime() << "s" << endl;
+        uaiger->show_statistics();
+        cout << "No output asserted in the first " << bmc_frame_k - 1 << " frames." << endl;
+        return UNDECIDED;
+    }
     // res = 0
     uaiger->show_statistics();
     cout << "No output asserted in frames." << endl; 
@@ -411,26 +406,10 @@ int BMC::solve_one_frame(){
     int bad = (uaiger->outputs).back();
     cout << "frames = "<< bmc_frame_k <<", bad = " << bad << ", res = ";
 
-    set<int> lit_set;
-    lit_set.insert(abs(bad));
     //for(int cst : constraints) lit_set.insert(abs(cst));
-    
-    for(int i = (uaiger->ands).size()-1; i>=0; i--){   
-        And a = uaiger->ands[i];            
-        //Check if this AND gate has been added and if it needs to be a COI
-        if(lit_has_insert[i] == 1 || lit_set.find(a.o) == lit_set.end()){
-            continue;
-        }
-
-        lit_set.erase(a.o);        
-        lit_has_insert[i] = 1;
-        lit_set.insert(abs(a.i1));
-        lit_set.insert(abs(a.i2));
-        
-        bmcSolver->add(-a.o); bmcSolver->add(a.i1);  bmcSolver->add(0);
-        bmcSolver->add(-a.o); bmcSolver->add(a.i2);  bmcSolver->add(0);
-        bmcSolver->add(a.o);  bmcSolver->add(-a.i1); bmcSolver->add(-a.i2); bmcSolver->add(0);
-    }
+    vector<int> cnf;
+    cone.encode(uaiger->ands, vector<int>(1, bad), cnf, &lit_has_insert);
+    bmcSolver->add_cnf(cnf);
 
     bmcSolver->assume(bad);
     int result = bmcSolver->solve();
@@ -136,6 +136,7 @@ public:
     CaDiCaL *bmcSolver = nullptr;
     int bmc_frame_k;
     vector<bool> lit_has_insert; 
+    Cone_encoder cone;      // over uaiger->ands
     
     // Parameters & statistics
     std::chrono::_V2::steady_clock::time_point start_time;
@@ -158,7 +159,7 @@ public:
     int Aig_And(int lc, int rc);
     void unfold();
     double get_runtime();
-    void encode_init_condition(SATSolver *s);
+    void encode_init_condition(CaDiCaL *s);
     int solve();
     int solve_one_frame();
 
@@ -45,6 +45,7 @@ public:
             Cube cc = c;
             //pdr_->show_litvec(cc);
             for(int l:cc){ 
+                l = pdr_->origin_lit(l);    // PDR works on the cone of influence
                 int unfold_l = (l > 0 ? (bmc_->values[l]) : -(bmc_->values[-l]));
                 (bmc_->bmcSolver)->add(-unfold_l); 
             }
@@ -77,35 +78,44 @@ public:
         //     cout << endl;  
         // } 
 
-        while(true){ 
-            frame_index++;  
-            /// PDR
-            cout << "PDR start frame " << frame_index << endl;    
-            int pdr_res = pdr_->incremental_check();
-            if(pdr_res != -1)   return pdr_res;
-            //printcube();
+        try{
+            while(true){ 
+                frame_index++;  
+                /// PDR
+                cout << "PDR start frame " << frame_index << endl;    
+                int pdr_res = pdr_->incremental_check();
+                if(pdr_res != -1)   return pdr_res;
+                //printcube();
 
-            /// BMC     
-            cout << "BMC start frame " << frame_index << " " << frame_index+1 << endl;     
-            bmc_->unfold();
-            //addcube(); 
-            bmc_->bmc_frame_k++;
-            bmc_->unfold();
-            bmc_->bmc_frame_k++;
-            int bmc_res = (bmc_->solve_one_frame());
-            if(bmc_res == 10){
-                (bmc_->uaiger)->show_statistics();
-                cout << "Output was asserted in frame." << endl;
-                return 1; 
-            }    
-            //cout << endl;  
+                /// BMC     
+                cout << "BMC start frame " << frame_index << " " << frame_index+1 << endl;     
+                bmc_->unfold();
+                //addcube(); 
+                bmc_->bmc_frame_k++;
+                bmc_->unfold();
+                bmc_->bmc_frame_k++;
+                int bmc_res = (bmc_->solve_one_frame());
+                if(bmc_res == 10){
+                    (bmc_->uaiger)->show_statistics();
+                    cout << "Output was asserted in frame." << endl;
+                    return 1; 
+                }    
+                //cout << endl;  
 
-            frame_index++;  
-            // PDR
-            cout << "PDR start frame " << frame_index << endl;    
-            pdr_res = pdr_->incremental_check2();
-            if(pdr_res != -1)   return pdr_res;  
-            cout << endl;            
-        } 
+                frame_index++;  
+                // PDR
+                cout << "PDR start frame " << frame_index << endl;    
+                pdr_res = pdr_->incremental_check2();
+                if(pdr_res != -1)   return pdr_res;  
+                cout << endl;            
+            }
+        }catch(Limit_reached &){
+            cout << endl << "c limits reached after " << pdr_->get_runtime() << "s" << endl;
+            printinfo_pdr();
+            cout << "BMC finish frame " << bmc_->bmc_frame_k << endl;
+            (bmc_->uaiger)->show_statistics();
+            pdr_->show_statistics();
+            return UNDECIDED;
+        }
     }
 };
\ No newline at end of file
@@ -3,24 +3,27 @@
 #include <assert.h>
 #include <sstream>
 #include <algorithm>
+#include <memory>
 
 unsigned long long state_count = 0;
+Resource_limits limits;
 
 //  Log functions
 // --------------------------------------------
 void PDR::show_state(State *s){
-    vector<char> a(nInputs + nLatches + 2, 'x');
+    // printed in the numbering of the loaded model, outside the cone is 'x'
+    vector<char> a(origin->num_inputs + origin->num_latches + 2, 'x');
     for(int i : s->inputs)
-        a[abs(i)] = (i<0?'0':'1');
+        a[abs(origin_lit(i))] = (i<0?'0':'1');
     for(int l : s->latches)
-        a[abs(l)] = (l<0?'0':'1');
+        a[abs(origin_lit(l))] = (l<0?'0':'1');
     
     cout<<'[';
-    for(int i=1; i<=nInputs; ++i)
+    for(int i=1; i<=origin->num_inputs; ++i)
         cout<<a[1+i];
     cout<<'|';
-    for(int l=1; l<=nLatches; ++l)
-        cout<<a[1+nInputs+l];
+    for(int l=1; l<=origin->num_latches; ++l)
+        cout<<a[1+origin->num_inputs+l];
     cout<<']';
     cout<<endl;
 }
@@ -121,8 +124,8 @@ void PDR::show_aag(){
         cout<<2*i<<endl;
     for(int i=1; i<=nLatches; ++i){
         cout<<2*(nInputs+i)<<" "<<dimacs_to_aiger(nexts[i-1]);
-        if(aiger->latches[i-1].default_val != 0)
-            cout<<" "<<aiger->latches[i-1].default_val;
+        if(aiger->latch_default[i-1] != 0)
+            cout<<" "<<aiger->latch_default[i-1];
         cout<<endl;
     }
     
@@ -145,10 +148,12 @@ int PDR::prime_var(int var){
         if(var <= 1 + nInputs + nLatches){
             return primed_first_dimacs + var - 2; 
         }else{
-            if(map_to_prime.find(var) == map_to_prime.end()){
+            assert(var < map_to_prime.size());
+            if(map_to_prime[var] == 0){
                 int unprimed_var = var;
                 int primed_var = variables.size();
                 map_to_prime[unprimed_var] = primed_var;
+                map_to_unprime.resize(primed_var + 1, 0);
                 map_to_unprime[primed_var] = unprimed_var;
                 string new_name = variables[unprimed_var].name + string("'");
                 variables.push_back(Variable(primed_var, new_name));
@@ -172,8 +177,98 @@ int PDR::prime_lit(int lit){
 }
 
 
+int PDR::origin_lit(int lit){
+    int var = abs(lit), res;
+    if(var < unprimed_first_dimacs + nInputs)
+        res = unprimed_first_dimacs + coi_inputs[var - unprimed_first_dimacs];
+    else{
+        assert(var < unprimed_first_dimacs + nInputs + nLatches);
+        res = unprimed_first_dimacs + origin->num_inputs + coi_latches[var - unprimed_first_dimacs - nInputs];
+    }
+    return lit < 0 ? -res : res;
+}
+
+
+// sequential cone of influence: keep the inputs, latches and ands that the
+// selected property or a constraint depends on through any number of steps,
+// and renumber them into a smaller aiger (the property becomes bad 0).
 void PDR::simplify_aiger(){
-    //TODO: rewriting aiger
+    Aiger *a = origin;
+    unsigned I = a->num_inputs, L = a->num_latches, A = a->num_ands;
+    unsigned b;
+    if(a->num_bads > 0 && a->num_bads > property_index)
+        b = a->bads[property_index];
+    else if(a->num_outputs > 0 && a->num_outputs > property_index)
+        b = a->outputs[property_index];
+    else
+        assert(false);
+
+    vector<char> in_cone(1 + I + L + A, 0);
+    vector<unsigned> todo;
+    auto reach = [&](unsigned lit){
+        unsigned v = lit >> 1;
+        if(v == 0 || in_cone[v]) return;
+        in_cone[v] = 1;
+        todo.push_back(v);
+    };
+    reach(b);
+    for(unsigned c : a->constraints)
+        reach(c);
+    while(!todo.empty()){
+        unsigned v = todo.back();
+        todo.pop_back();
+        if(v > I + L){
+            reach(a->and_i1[v - I - L - 1]);
+            reach(a->and_i2[v - I - L - 1]);
+        }else if(v > I)
+            reach(a->latch_next[v - I - 1]);
+    }
+
+    coi_inputs.clear();
+    coi_latches.clear();
+    vector<unsigned> to(1 + I + L + A, 0);
+    unsigned n = 0, nands = 0;
+    for(unsigned i=0; i<I; ++i)
+        if(in_cone[1 + i]){coi_inputs.push_back(i); to[1 + i] = ++n;}
+    for(unsigned i=0; i<L; ++i)
+        if(in_cone[1 + I + i]){coi_latches.push_back(i); to[1 + I + i] = ++n;}
+    for(unsigned i=0; i<A; ++i)
+        if(in_cone[1 + I + L + i]){to[1 + I + L + i] = ++n; ++nands;}
+    if(n == I + L + A)
+        return;
+    auto map_lit = [&](unsigned lit){return 2 * to[lit >> 1] + (lit & 1);};
+
+    Aiger *r = new Aiger;
+    r->num_inputs = coi_inputs.size();
+    r->num_latches = coi_latches.size();
+    r->num_ands = nands;
+    r->max_var = n;
+    r->num_bads = 1;
+    r->num_constraints = a->num_constraints;
+    for(unsigned i=0; i<r->num_inputs; ++i)
+        r->inputs.push_back(2 * (i + 1));
+    r->latch_next.reserve(r->num_latches);
+    r->latch_default.reserve(r->num_latches);
+    for(unsigned i=0; i<r->num_latches; ++i){
+        unsigned k = coi_latches[i], d = a->latch_default[k];
+        r->latch_next.push_back(map_lit(a->latch_next[k]));
+        r->latch_default.push_back(d <= 1 ? d : r->latch_lit(i));
+    }
+    r->and_i1.reserve(nands);
+    r->and_i2.reserve(nands);
+    for(unsigned i=0; i<A; ++i){
+        if(!in_cone[1 + I + L + i]) continue;
+        r->and_i1.push_back(map_lit(a->and_i1[i]));
+        r->and_i2.push_back(map_lit(a->and_i2[i]));
+    }
+    r->bads.push_back(map_lit(b));
+    for(unsigned c : a->constraints)
+        r->constraints.push_back(map_lit(c));
+
+    if(aig_veb > 0)
+        cout<<"c COI: inputs "<<I<<" -> "<<r->num_inputs<<", latches "<<L<<" -> "<<r->num_latches<<", ands "<<A<<" -> "<<nands<<endl;
+    aiger = r;
+    property_index = 0;
 }
 
 // translate the aiger language to internal states
@@ -200,17 +295,17 @@ void PDR::translate_to_dimacs(){
     // load latches
     nLatches = aiger->num_latches;
     for(int i=1; i<=nLatches; ++i){
-        assert((nInputs+i)*2 == aiger->latches[i-1].l);
+        assert((nInputs+i)*2 == aiger->latch_lit(i-1));
         variables.push_back(Variable(1 + nInputs + i, 'l', i-1, false));
     }
     
     // load ands
     nAnds = aiger->num_ands;
     for(int i=1; i<=nAnds; ++i){
-        assert(2*(nInputs+nLatches+i) == aiger->ands[i-1].o);
+        assert(2*(nInputs+nLatches+i) == aiger->and_lit(i-1));
         int o = 1+nInputs+nLatches+i;
-        int i1 = aiger_to_dimacs(aiger->ands[i-1].i1);
-        int i2 = aiger_to_dimacs(aiger->ands[i-1].i2);
+        int i1 = aiger_to_dimacs(aiger->and_i1[i-1]);
+        int i2 = aiger_to_dimacs(aiger->and_i2[i-1]);
         variables.push_back(Variable(o, 'a', i-1, false));
         ands.push_back(And(o, i1, i2));
     }
@@ -218,12 +313,12 @@ void PDR::translate_to_dimacs(){
     // deal with initial states
     for(int i=1; i<=nLatches; ++i){
         int l = 1 + nInputs + i;
-        assert((l-1)*2 == aiger->latches[i-1].l);
-        Aiger_latches & al = aiger->latches[i-1];
-        nexts.push_back(aiger_to_dimacs(al.next));
-        if(al.default_val==0){
+        assert((l-1)*2 == aiger->latch_lit(i-1));
+        unsigned default_val = aiger->latch_default[i-1];
+        nexts.push_back(aiger_to_dimacs(aiger->latch_next[i-1]));
+        if(default_val==0){
             init_state.push_back(-l);
-        }else if(al.default_val==1){
+        }else if(default_val==1){
             init_state.push_back(l);
         }
     }
@@ -249,6 +344,7 @@ void PDR::translate_to_dimacs(){
     // load inputs prime
     primed_first_dimacs = variables.size();
     assert(primed_first_dimacs == 1 + nInputs + nLatches + nAnds + 1);
+    map_to_prime.assign(primed_first_dimacs, 0);
     for(int i=0; i<nInputs; ++i){
         variables.push_back(
             Variable(primed_first_dimacs + i, 'i', i, true));
@@ -316,7 +412,7 @@ void PDR::updateLitOrder(Cube &cube, int level){
 
 
 void PDR::initialize(){
-    satelite = nullptr;
+    translation.clear();
     simplify_aiger();
     translate_to_dimacs();
     initialize_heuristic();
@@ -326,15 +422,35 @@ void PDR::initialize(){
 }
 
 
+// Each frame has its own solver holding T. With use_ss all frames share the
+// solver of frame 0 instead, as in ABC's PDR or IC3ref: the lemmas of frame k
+// are guarded by its activation variable, which implies the one of frame
+// k+1, so assuming it at a query enables the lemmas of frames >= k.
 void PDR::new_frame(){
     int last = frames.size();
-    frames.push_back(Frame());
+    if(use_ss && last > 0){
+        Backend *s = frames[0].solver;
+        frames.push_back(Frame(s));
+        frames[last].act = s->new_var();
+        int chain[2] = {-frames[last-1].act, frames[last].act};
+        s->add_clause(chain, 2);
+        return;
+    }
+    frames.push_back(Frame(new Backend()));
     encode_translation(frames[last].solver);
     // Goal of frame-k is to find a pre-condition or prove clause c inductive to k-1.
-    for(int l : constraints_prime){
-        frames[last].solver->add(l); 
-        frames[last].solver->add(0);
+    for(int l : constraints_prime)
+        frames[last].solver->add_clause(&l, 1);
+    if(use_ss)
+        frames[last].act = frames[last].solver->new_var();
+}
+
+void PDR::delete_frames(){
+    for(int i=0; i<frames.size(); ++i){
+        if(frames[i].solver != nullptr && (i == 0 || !use_ss))
+            delete frames[i].solver;
     }
+    frames.clear();
 }
 
 int add_ct = 0;
@@ -349,31 +465,60 @@ void PDR::add_cube(Cube &cube, int k, bool to_all, bool ispropagate){
         show_litvec(cube);
     }
     
-    if(to_all){
-        for(int i=1; i< k; ++i){
-            for(int l : cube)
-                frames[i].solver->add(-l);
-            frames[i].solver->add(0);
-        }   
-    }
+    vector<int> clause;
     for(int l : cube)
-        frames[k].solver->add(-l);
-    frames[k].solver->add(0);
+        clause.push_back(-l);
+    if(use_ss){
+        clause.push_back(-frames[k].act);
+        frames[k].solver->add_clause(clause);
+    }else if(to_all){
+        for(int i=1; i< k; ++i)
+            frames[i].solver->add_clause(clause);
+        frames[k].solver->add_clause(clause);
+    }else
+        frames[k].solver->add_clause(clause);
     
     // update heuristics
     if(use_heuristic and !ispropagate) updateLitOrder(cube, k);
 }
 
 
+int PDR::solve(Backend *solver, Sat_site site, bool propagate_first){
+    long long c = solver->conflicts(), d = solver->decisions(), p = solver->propagations();
+    auto t = std::chrono::steady_clock::now();
+    int res = 0;
+    if(propagate_first && option_propagate_first)
+        res = solver->propagate();
+    Sat_profile &sp = sat_profile[site];
+    if(res == UNSAT)
+        ++sp.propagated;
+    else
+        res = solver->solve();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t;
+    ++sp.calls;
+    if(res == SAT) ++sp.sat;
+    if(res == UNSAT) ++sp.unsat;
+    sp.conflicts += solver->conflicts() - c;
+    sp.decisions += solver->decisions() - d;
+    sp.propagations += solver->propagations() - p;
+    sp.seconds += elapsed.count();
+    long long us = elapsed.count() * 1e6;
+    int b = 0;
+    while(us > 0 && b < Sat_profile::nbuckets - 1){
+        us >>= 1;
+        ++b;
+    }
+    ++sp.hist[b];
+    return res;
+}
+
 bool PDR::is_init(vector<int> &latches){
     if(!init){
-        init = new CaDiCaL();
-        // init = new minisatCore();
+        init = new Backend();
         encode_init_condition(init);
     }
-    for(int l : latches)
-        init->assume(l);
-    int res = init->solve();
+    init->assume_all(latches);
+    int res = solve(init, site_init);
     assert(res != 0);
     return (res == SAT);
 }
@@ -381,18 +526,17 @@ bool PDR::is_init(vector<int> &latches){
 // check ~latches inductive by Fi /\ -s /\ T /\ s'
 // Fi /\ -latches /\ [constraints /\ -bad /\ T] /\ constraints' /\ latches'
 int core_ct = 0;
-bool PDR::is_inductive(SATSolver *solver, int fi, const Cube &latches, bool gen_core, bool reverse_assumption){
+bool PDR::is_inductive(Backend *solver, int fi, const Cube &latches, Sat_site site, bool gen_core, bool reverse_assumption){
     if(use_pc){ 
         Cube succ = latches;
         for (auto inductive_cube: frames[fi].succ_push) {
             if(inductive_cube.size() > succ.size()) break;
             if(includes(succ.begin(), succ.end(), inductive_cube.begin(), inductive_cube.end())){  
                 solver->clear_act();
-                vector<int> assumptions;
-                int act = solver->max_var() + 1;
-                solver->add(-act);
-                for(int i : inductive_cube)  solver->add(-i);  
-                solver->add(0);  
+                vector<int> assumptions, clause;
+                int act = solver->new_act();
+                for(int i : inductive_cube)  clause.push_back(-i);
+                solver->group_clause(act, clause);
 
                 for(int i : inductive_cube)
                     assumptions.push_back(i);
@@ -403,16 +547,18 @@ bool PDR::is_inductive(SATSolver *solver, int fi, const Cube &latches, bool gen_
                     assumptions[i] = prime_lit(assumptions[i]);
                 }
 
-                solver->assume(act);
-                for(int i: assumptions) solver->assume(i);
+                assume_frame(solver, fi);
+                solver->assume_all(assumptions);
+                solver->assume(act);    // last, so that consecutive queries share a prefix
 
-                int status = solver->solve();
+                int status = solve(solver, site, true);
                 ++nQuery;
                 assert(status == UNSAT);
                 if(gen_core){
+                    load_core(solver);
                     core.clear();
                     for(int i : inductive_cube){
-                        if(solver->failed(prime_lit(i)))
+                        if(in_core(prime_lit(i)))
                             core.push_back(i);
                     }
                     if(is_init(core)){
@@ -426,12 +572,11 @@ bool PDR::is_inductive(SATSolver *solver, int fi, const Cube &latches, bool gen_
         }   
     } 
     solver->clear_act();
-    vector<int> assumptions;
-    int act = solver->max_var() + 1;
-    solver->add(-act);
-    for(int i : latches)   
-        solver->add(-i);  
-    solver->add(0);
+    vector<int> assumptions, clause;
+    int act = solver->new_act();
+    for(int i : latches)
+        clause.push_back(-i);
+    solver->group_clause(act, clause);
 
     if(use_heuristic){
         for(int i : latches)
@@ -449,19 +594,22 @@ bool PDR::is_inductive(SATSolver *solver, int fi, const Cube &latches, bool gen_
         stable_sort(assumptions.begin(), assumptions.end(), Lit_CMP());
     }
 
+    assume_frame(solver, fi);
+    solver->assume_all(assumptions);
     solver->assume(act);
-    for(int i: assumptions)
-        solver->assume(i);
 
-    int status = solver->solve();
+    int status = solve(solver, site, true);
     ++nQuery;
     assert(status != 0);
     bool res = (status == UNSAT);
 
     if(res & gen_core){
+        load_core(solver);
+        if(use_cm && site == site_block)
+            minimize_core(solver, fi, act, latches, assumptions);
         core.clear();
         for(int i : latches){
-            if(solver->failed(prime_lit(i)))
+            if(in_core(prime_lit(i)))
                 core.push_back(i);
         }
         if(is_init(core)){
@@ -474,51 +622,201 @@ bool PDR::is_inductive(SATSolver *solver, int fi, const Cube &latches, bool gen_
     return res;
 }
 
+// Bounded core minimization: the query is repeated with only the failed
+// cube literals, in reverse order, which often yields a smaller core.  Stops
+// after option_core_min_rounds re-solves, when the core no longer shrinks or
+// when the smaller core would intersect I (the previous one is kept then).
+void PDR::minimize_core(Backend *solver, int fi, int act, const Cube &latches, vector<int> assumptions){
+    for(int round = 0; round < option_core_min_rounds; ++round){
+        vector<int> lits;
+        for(int l : assumptions)
+            if(in_core(l))
+                lits.push_back(l);
+        if(lits.size() <= 1)
+            return;
+        reverse(lits.begin(), lits.end());
+        assume_frame(solver, fi);
+        solver->assume_all(lits);
+        solver->assume(act);
+        int status = solve(solver, site_core, true);
+        ++nQuery;
+        ++nCoreMin;
+        assert(status == UNSAT);
+        vector<int> prev = failed;
+        load_core(solver);
+        int dropped = 0;
+        for(int l : lits)
+            if(!in_core(l))
+                ++dropped;
+        if(dropped == 0)
+            return;
+        Cube smaller;
+        for(int i : latches)
+            if(in_core(prime_lit(i)))
+                smaller.push_back(i);
+        if(is_init(smaller)){
+            failed = prev;
+            return;
+        }
+        nCoreMinLits += dropped;
+        assumptions = lits;
+    }
+}
+
+
+static const int cnf_max_and_leaves = 8;
+
+void Cone_encoder::encode(const vector<And> &ands, const vector<int> &roots, vector<int> &cnf, vector<bool> *encoded, bool polar){
+    int nv = pos.size();
+    for(size_t i = npos; i < ands.size(); ++i)
+        nv = max(nv, ands[i].o + 1);
+    for(int l : roots)
+        nv = max(nv, abs(l) + 1);
+    if(nv > pos.size()){
+        pos.resize(nv, -1);
+        stamp.resize(nv, 0);
+        refs.resize(nv);
+        pol.resize(nv);
+    }
+    for(; npos < ands.size(); ++npos)
+        pos[ands[npos].o] = npos;
+    if(++epoch == 0){
+        fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+    auto done = [&](int i){ return encoded != nullptr && (*encoded)[i]; };
+    auto touch = [&](int v){
+        if(stamp[v] != epoch){
+            stamp[v] = epoch;
+            refs[v] = 0;
+            pol[v] = 0;
+        }
+    };
+
+    // fanout counts inside the cone; roots count as outside fanout
+    for(int l : roots){
+        touch(abs(l));
+        refs[abs(l)] += 2;
+    }
+    for(int i = ands.size()-1; i >= 0; --i){
+        const And &a = ands[i];
+        if(stamp[a.o] != epoch || done(i))
+            continue;
+        touch(abs(a.i1));
+        touch(abs(a.i2));
+        refs[abs(a.i1)]++;
+        refs[abs(a.i2)]++;
+    }
+    // an and that can be folded into its only reader
+    auto inner = [&](int lit){
+        int v = abs(lit);
+        return pos[v] >= 0 && stamp[v] == epoch && refs[v] == 1 && !done(pos[v]);
+    };
+    // o = -(s & t | -s & e), built as o = -(s & t) & -(-s & e)
+    auto mux = [&](const And &a, int &s, int &t, int &e){
+        if(a.i1 > 0 || a.i2 > 0 || !inner(a.i1) || !inner(a.i2))
+            return false;
+        const And &x = ands[pos[-a.i1]], &y = ands[pos[-a.i2]];
+        int xs[2] = {x.i1, x.i2}, ys[2] = {y.i1, y.i2};
+        for(int p=0; p<2; ++p)
+            for(int q=0; q<2; ++q)
+                if(xs[p] == -ys[q]){
+                    s = xs[p]; t = xs[1-p]; e = ys[1-q];
+                    return true;
+                }
+        return false;
+    };
+
+    // polarity a variable is used in: 1 it may be required true, 2 false
+    for(int l : roots)
+        pol[abs(l)] |= polar ? (l > 0 ? 1 : 2) : 3;
+    // clause[0] is the gate output; the clause is only needed if the
+    // output is used in the polarity the clause constrains
+    auto emit = [&](){
+        if(!(pol[abs(clause[0])] & (clause[0] < 0 ? 1 : 2)))
+            return;
+        for(int k=1; k<clause.size(); ++k)
+            pol[abs(clause[k])] |= polar ? (clause[k] > 0 ? 1 : 2) : 3;
+        cnf.insert(cnf.end(), clause.begin(), clause.end());
+        cnf.push_back(0);
+    };
+
+    for(int i = ands.size()-1; i >= 0; --i){
+        const And &a = ands[i];
+        if(stamp[a.o] != epoch || pol[a.o] == 0 || done(i))
+            continue;
+        if(encoded != nullptr)
+            (*encoded)[i] = true;
+
+        int s, t, e;
+        if(mux(a, s, t, e)){
+            int f = -a.o;
+            int c[6][3] = {{f, -s, -t}, {-f, -s, t}, {f, s, -e}, {-f, s, e}, {f, -t, -e}, {-f, t, e}};
+            // for an XOR (t == -e) the last two clauses are tautologies
+            for(int k=0; k < (t == -e ? 4 : 6); ++k){
+                clause.assign(c[k], c[k] + 3);
+                emit();
+            }
+            continue;
+        }
+
+        // multi-input and: expand positive inner fanins that are not muxes
+        leaves.clear();
+        stack.clear();
+        stack.push_back(a.i1);
+        stack.push_back(a.i2);
+        while(!stack.empty()){
+            int l = stack.back();
+            stack.pop_back();
+            if(l > 0 && inner(l) && !mux(ands[pos[l]], s, t, e)
+               && leaves.size() + stack.size() + 2 <= cnf_max_and_leaves){
+                stack.push_back(ands[pos[l]].i1);
+                stack.push_back(ands[pos[l]].i2);
+            }else if(find(leaves.begin(), leaves.end(), l) == leaves.end())
+                leaves.push_back(l);
+        }
+        for(int l : leaves){
+            clause.assign(1, -a.o);
+            clause.push_back(l);
+            emit();
+        }
+        clause.assign(1, a.o);
+        for(int l : leaves)
+            clause.push_back(-l);
+        emit();
+    }
+}
 
-void PDR::encode_init_condition(SATSolver *s){
-    s->add(-1); s->add(0); 
+void PDR::encode_init_condition(Backend *s, int act){
+    vector<int> cnf;
+    cnf.push_back(-1); cnf.push_back(0);
     for(int l : init_state){
-        s->add(l); s->add(0);
+        cnf.push_back(l); cnf.push_back(0);
     }
 
     if(constraints.size() >= 0){
         for(int l : constraints){
-            s->add(l); s->add(0);}
+            cnf.push_back(l); cnf.push_back(0);}
 
-        set<int> lit_set;
-        for(int l : constraints)
-            lit_set.insert(abs(l));
-
-        for(auto i = ands.rbegin(); i != ands.rend(); ++i){
-            And & a = *i;
-            if(lit_set.find(a.o) == lit_set.end())
-                continue;
-            lit_set.insert(a.i1);
-            lit_set.insert(a.i2);//??????
-            
-            s->add(-a.o); s->add(a.i1);  s->add(0);
-            s->add(-a.o); s->add(a.i2);  s->add(0);
-            s->add(a.o);  s->add(-a.i1); s->add(-a.i2); s->add(0);
+        cone.encode(ands, constraints, cnf, nullptr, use_pg);
+    }
+    if(act){
+        vector<int> guarded;
+        for(int l : cnf){
+            if(l == 0) guarded.push_back(-act);
+            guarded.push_back(l);
         }
+        cnf.swap(guarded);
     }
+    s->add_cnf(cnf);
     if(aig_veb > 2)
         cout<<"c add_cls finish load init"<<endl;
 }
 
-void PDR::encode_bad_state(SATSolver *s){
-    set<int> lit_set;
-    lit_set.insert(abs(bad));
-    for(auto i = ands.rbegin(); i != ands.rend(); ++i){
-        And & a = *i;
-        assert(a.o > 0);
-        if(lit_set.find(a.o) == lit_set.end())
-            continue;
-        lit_set.insert(abs(a.i1));
-        lit_set.insert(abs(a.i2));
-        s->add(-a.o); s->add(a.i1);  s->add(0);
-        s->add(-a.o); s->add(a.i2);  s->add(0);
-        s->add(a.o);  s->add(-a.i1); s->add(-a.i2); s->add(0);
-    }
+void PDR::encode_bad_state(Backend *s){
+    vector<int> cnf;
+    cone.encode(ands, vector<int>(1, bad), cnf, nullptr, use_pg);
+    s->add_cnf(cnf);
     if(aig_veb > 2)
         cout<<"c add_cls finish load bad"<<endl;
 }
@@ -528,77 +826,107 @@ void PDR::encode_bad_state(SATSolver *s){
 // lift a pre-state by Fi /\ pre /\ T /\ -s' (assert UNSAT)
 // Fi /\ inputs /\ latches /\ [constraints /\ -bad /\ T] /\ inputs' /\ -(constraints' /\ latches') 
 // translation encoding: [constraints /\ -bad /\ T]
-void PDR::encode_translation(SATSolver *s){
-    if(satelite == nullptr){
-        satelite = new minisatSimp();
-        satelite->var_enlarge_to(variables.size()-1);
+void PDR::encode_translation(Backend *s){
+    if(translation.empty()){
+        // the pre-pass may eliminate anything but the frozen interface variables
+        SATSolver *pre;
+        minisatSimp *satelite = nullptr;
+        CaDiCaL *cadical = nullptr;
+        if(use_ce){
+            pre = cadical = new CaDiCaL();
+            cadical->set_option("elimineff", option_ce_effort);
+            cadical->set_option("subsumemineff", option_ce_effort);
+            cadical->set_option("probemineff", option_ce_effort);
+        }else{
+            pre = satelite = new minisatSimp();
+            satelite->var_enlarge_to(variables.size()-1);
+        }
+        auto freeze = [&](int var){
+            if(use_ce) cadical->freeze(var);
+            else satelite->set_frozen(var);
+        };
 
         for(int i=1; i<= nInputs+nLatches; ++i){
-            satelite->set_frozen(1 + i);
-            satelite->set_frozen(prime_var(1 + i));
+            freeze(1 + i);
+            freeze(prime_var(1 + i));
         }
-        satelite->set_frozen(abs(bad));
-        satelite->set_frozen(abs(bad_prime));
+        freeze(abs(bad));
+        freeze(abs(bad_prime));
         for(int i=0; i<constraints.size(); ++i){
-            satelite->set_frozen(abs(constraints[i]));
-            satelite->set_frozen(abs(constraints_prime[i]));
+            freeze(abs(constraints[i]));
+            freeze(abs(constraints_prime[i]));
         }
         
-        set<int> prime_lit_set;
-        prime_lit_set.insert(abs(bad));
-        for(int l : constraints)
-            prime_lit_set.insert(abs(l));
-
-        set<int> lit_set(prime_lit_set.begin(), prime_lit_set.end());
-        for(int l : nexts)
-            lit_set.insert(abs(l));
-        
+        // with use_pg only the polarity each root is used in is encoded:
+        // -bad and the constraints are asserted, the nexts are equated with
+        // the primed latches, and bad' and the constraints' are assumed by
+        // the frames and negated by the lift solver
+        vector<int> roots(constraints);
+        roots.push_back(-bad);
+        vector<int> prime_roots;
+        for(int l : nexts){
+            roots.push_back(l);
+            roots.push_back(-l);
+        }
+        for(int l : constraints){
+            prime_roots.push_back(l);
+            prime_roots.push_back(-l);
+        }
+        prime_roots.push_back(bad);
+        prime_roots.push_back(-bad);
 
-        satelite->add(-1); satelite->add(0);    // literal 1 is const 'T'
-        satelite->add(-bad); satelite->add(0);  // -bad must hold !
-        for(int l : constraints){satelite->add(l);satelite->add(0);}
-        // for(int l : constraints_prime){satelite->add(l); satelite->add(0);}
+        pre->add(-1); pre->add(0);    // literal 1 is const 'T'
+        pre->add(-bad); pre->add(0);  // -bad must hold !
+        for(int l : constraints){pre->add(l);pre->add(0);}
+        // for(int l : constraints_prime){pre->add(l); pre->add(0);}
         for(int i=0; i<nLatches; ++i){
             int l = 1 + nInputs + i + 1;
             int pl = prime_lit(l);
             int next = nexts[i];
-            satelite->add(-pl);satelite->add(next); satelite->add(0);
-            satelite->add(-next); satelite->add(pl); satelite->add(0);
+            pre->add(-pl);pre->add(next); pre->add(0);
+            pre->add(-next); pre->add(pl); pre->add(0);
         }
 
 
-        for(auto i = ands.rbegin(); i != ands.rend(); ++i){
-            And &a = *i;
-            assert(a.o > 0);
-
-            if(lit_set.find(a.o) != lit_set.end()){
-                lit_set.insert(abs(a.i1));
-                lit_set.insert(abs(a.i2));
-                
-                satelite->add(-a.o); satelite->add(a.i1);  satelite->add(0);
-                satelite->add(-a.o); satelite->add(a.i2);  satelite->add(0);
-                satelite->add(a.o);  satelite->add(-a.i1); satelite->add(-a.i2); satelite->add(0);
-                
-
-                if(prime_lit_set.find(a.o) != prime_lit_set.end()){
-                    int po  = prime_lit(a.o);
-                    int pi1 = prime_lit(a.i1);
-                    int pi2 = prime_lit(a.i2);
-
-                    prime_lit_set.insert(abs(a.i1));
-                    prime_lit_set.insert(abs(a.i2));
-                    satelite->add(-po); satelite->add(pi1);  satelite->add(0);
-                    satelite->add(-po); satelite->add(pi2);  satelite->add(0);
-                    satelite->add(po);  satelite->add(-pi1); satelite->add(-pi2); satelite->add(0);
-
-                }
-            }
+        vector<int> cnf;
+        cone.encode(ands, roots, cnf, nullptr, use_pg);
+        pre->add_cnf(cnf);
+
+        // the bad and constraint cones are also needed over the primed variables
+        cnf.clear();
+        cone.encode(ands, prime_roots, cnf, nullptr, use_pg);
+        for(int &l : cnf)
+            if(l != 0) l = prime_lit(l);
+        pre->add_cnf(cnf);
+
+        if(use_ce){
+            auto t = chrono::steady_clock::now();
+            long long vars = cadical->active(), clauses = cadical->irredundant();
+            cadical->simplify();
+            // the tautology keeps max_var() of the solvers above every variable
+            int nv = variables.size() - 1;
+            translation.push_back(nv);
+            translation.push_back(-nv);
+            translation.push_back(0);
+            cadical->export_clauses(translation);
+            cout<<"c cadical simplify: vars "<<vars<<" -> "<<cadical->active()
+                <<", clauses "<<clauses<<" -> "<<cadical->irredundant()<<", "
+                <<chrono::duration<double>(chrono::steady_clock::now() - t).count()<<"s"<<endl;
+        }else{
+            satelite->simplify();
+            translation.swap(satelite->simplified_cnf);
         }
-        satelite->simplify();
+        delete pre;
     }
     
-    for(int l : satelite->simplified_cnf)
-        s->add(l);
+    if(s->max_var() == 0){
+        if(trans == nullptr){
+            trans = new Backend();
+            trans->add_cnf(translation);
+        }
+        s->copy_from(*trans);
+    }else
+        s->add_cnf(translation);
     if(aig_veb > 2)
         cout<<"c add_cls finish load translation"<<endl;
 }
@@ -609,19 +937,15 @@ void PDR::encode_translation(SATSolver *s){
 // Then call SAT?[pre /\ T /\ -succ']
 // pre must meet constraints. 
 int ext_ct = 0;
-void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
+void PDR::extract_state_from_sat(Backend *sat, State *s, State *succ){
     s->clear();
     if(lift == nullptr){
-        lift = new CaDiCaL();
-        // lift = new minisatCore();
+        lift = new Backend();
         encode_translation(lift);
     }
 
-    set<int> successor;
-    if(succ != nullptr) for(int l: succ->latches) successor.insert(l);
-    
     lift->clear_act();
-    vector<int> assumptions, latches, successor_assumption, input_asumption;
+    vector<int> assumptions, latches, successor_assumption, input_asumption, clause;
     int distance = primed_first_dimacs - (nInputs+nLatches+2);
     // inputs /\ inputs' /\ pre
     for(int i=0; i<nInputs; ++i){
@@ -652,18 +976,17 @@ void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
     }
 
     // encoding -(constraints' /\ pre') <-> -constraints' \/ -pre'
-    int act_var = lift->max_var() + 1;
-    lift->add(-act_var);
+    int act_var = lift->new_act();
     for(int l : constraints_prime)
-        lift->add(-l);
+        clause.push_back(-l);
 
     if(succ == nullptr)
-        lift->add(-bad_prime);
+        clause.push_back(-bad_prime);
     else{
         for(int l: succ->latches)
-            lift->add(prime_lit(-l));        
+            clause.push_back(prime_lit(-l));
     }
-    lift->add(0);
+    lift->group_clause(act_var, clause);
 
     if(use_heuristic){
         stable_sort(assumptions.begin(), assumptions.end(), *heuristic_lit_cmp);
@@ -681,12 +1004,12 @@ void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
     stable_sort(successor_assumption.begin(), successor_assumption.end(), *heuristic_lit_cmp);
     reverse(successor_assumption.begin(), successor_assumption.end()); 
 
-    lift->assume(act_var);  
-    for(int l : assumptions)
-        lift->assume(l);
-    int res = lift->solve();
+    lift->assume_all(assumptions);
+    lift->assume(act_var);
+    int res = solve(lift, site_lift, true);
     ++nQuery;
     assert(res == UNSAT);
+    load_core(lift);
 
     if(output_stats_for_extract){
         cout << "assumptions ";
@@ -715,7 +1038,7 @@ void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
 
         cout << "lift ";
         for(int l : assumptions){
-            if(lift->failed(l))
+            if(in_core(l))
                 cout << variables[abs(l)].name << " ";
         }
         cout << endl;
@@ -727,7 +1050,7 @@ void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
         for(int i=0; i<assumptions.size(); i++){
             int l = assumptions[i];
             if(abs(l) >= nInputs+2 and abs(l) <= nInputs+nLatches+1) corelen++;
-            if(lift->failed(l)){
+            if(in_core(l)){
                 double score = (i-core_literal)/20.0;
                 if(score > 1.0) score = 1.05;
                 if(abs(l) < primed_first_dimacs)
@@ -744,7 +1067,7 @@ void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
             int l = assumptions[i];
             if(abs(l) >= nInputs+2 and abs(l) <= nInputs+nLatches+1) 
                 corelen++;
-            if(lift->failed(l))
+            if(in_core(l))
                 last_index = corelen;
         }           
     }
@@ -752,7 +1075,7 @@ void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
     nCorelen += last_index;
 
     for(int l : latches){
-        if(lift->failed(l))
+        if(in_core(l))
             s->latches.push_back(l);
     }
 
@@ -765,8 +1088,9 @@ void PDR::extract_state_from_sat(SATSolver *sat, State *s, State *succ){
 bool PDR::get_pre_of_bad(State *s){
     s->clear();
     int Fk = depth();
+    assume_frame(frames[Fk].solver, Fk);
     frames[Fk].solver->assume(bad_prime);
-    int res = frames[Fk].solver->solve();
+    int res = solve(frames[Fk].solver, site_bad);
     ++nQuery;
     
     if(res == SAT){
@@ -789,8 +1113,8 @@ bool PDR::rec_block_cube(){
             show_state(obl.state);
         }
         // check SAT?[Fk /\ -s /\ T /\ s']
-        SATSolver * sat = frames[obl.frame_k].solver;
-        if(is_inductive(sat, obl.frame_k, obl.state->latches, true)){
+        Backend *sat = frames[obl.frame_k].solver;
+        if(is_inductive(sat, obl.frame_k, obl.state->latches, site_block, true)){
             if(output_stats_for_recblock){
                 cout << "the obligation is already fulfilled, and cube is lifted to ";
                 show_litvec(core);
@@ -822,7 +1146,7 @@ bool PDR::rec_block_cube(){
                 frames[k].succ_push.insert(tmp_core); 
             for(k = obl.frame_k + 1; k<=depth(); ++k){
                 nPush++;
-                if(!is_inductive(frames[k].solver, k, tmp_core, false))
+                if(!is_inductive(frames[k].solver, k, tmp_core, site_push, false))
                     break;
                 if(use_pc) 
                     frames[k].succ_push.insert(tmp_core); 
@@ -884,7 +1208,7 @@ bool PDR::propagate(){
         if(use_pc) frames[i].succ_push.clear(); 
         int ckeep = 0, cprop = 0;
         for(auto ci = frames[i].cubes.begin(); ci!=frames[i].cubes.end();){
-            if(is_inductive(frames[i].solver, i, *ci, true)){
+            if(is_inductive(frames[i].solver, i, *ci, site_propagate, true)){
                 ++cprop;
                 // should add to frame k+1
                 if(core.size() < ci->size())
@@ -962,8 +1286,8 @@ bool PDR::CTG_down(Cube &cube, int k, int rec_depth, set<int> &required){
         if(is_init(cube)) 
             return false;
         // check inductive;
-        SATSolver *sat = frames[k].solver;
-        if(is_inductive(sat, k, cube, true)){
+        Backend *sat = frames[k].solver;
+        if(is_inductive(sat, k, cube, site_mic, true)){
             if(output_stats_for_ctg) cout << "The new cube satisfies induction" << endl;
             if(core.size() < cube.size()){
                 ++nCoreReduced;
@@ -983,7 +1307,7 @@ bool PDR::CTG_down(Cube &cube, int k, int rec_depth, set<int> &required){
             }
             // CTG
             if(ctg_ct < option_ctg_tries && k > 1 && !is_init(s->latches) 
-                && is_inductive(frames[k-1].solver, k-1, s->latches, true)){
+                && is_inductive(frames[k-1].solver, k-1, s->latches, site_ctg, true)){
                 if(output_stats_for_ctg){
                     cout << "ctg satisfies induction, is lifted to ";
                     show_litvec(core);
@@ -994,7 +1318,7 @@ bool PDR::CTG_down(Cube &cube, int k, int rec_depth, set<int> &required){
                 int i;
                 for(i=k; i<=depth(); ++i){
                     nPush++;
-                    if(!is_inductive(frames[i].solver, i, ctg, false))
+                    if(!is_inductive(frames[i].solver, i, ctg, site_push, false))
                         break;
                     if(use_pc) 
                         frames[i].succ_push.insert(ctg);
@@ -1049,20 +1373,20 @@ void PDR::clear_po(){
 bool PDR::check_BMC0(){
     assert(frames.size() == 0);
     // check SAT?[I /\ Bad] and push F0
-    SATSolver *sat0 = new CaDiCaL();
-    encode_init_condition(sat0);
-    encode_bad_state(sat0);
+    // owned, so a Limit_reached thrown by solve() does not leak it
+    unique_ptr<Backend> sat0(new Backend());
+    encode_init_condition(sat0.get());
+    encode_bad_state(sat0.get());
     sat0->assume(bad);
     int res = sat0->solve();
     if(res == SAT) {
         find_cex = true;
-        delete sat0;
         return false;
     }
-    delete sat0;
+    sat0.reset();
     // push F0
     new_frame();
-    encode_init_condition(frames[0].solver);
+    encode_init_condition(frames[0].solver, frames[0].act);
     return true;
 }
 
@@ -1070,9 +1394,9 @@ bool PDR::check_BMC1(){
     assert(frames.size() == 1);
     // push Foo
     // check SAT?[I /\ T /\ Bad'] and push Foo
-    SATSolver *sat1 = new CaDiCaL();
-    encode_init_condition(sat1);
-    encode_translation(sat1);
+    unique_ptr<Backend> sat1(new Backend());
+    encode_translation(sat1.get());
+    encode_init_condition(sat1.get());
     sat1->assume(bad_prime);
     int res1 = sat1->solve();
     if(res1 == SAT){
@@ -1083,87 +1407,92 @@ bool PDR::check_BMC1(){
         for(int i=0; i<nLatches; ++i)
             s->latches.push_back(sat1->val(unprimed_first_dimacs + nInputs + i));
         cex_states.push_back(s);
-        delete sat1;
         return false;
     }
-    delete sat1;
+    sat1.reset();
     new_frame();
     return true;
 }
 
-bool PDR::check(){
-    initialize();
-
-    if(!check_BMC0()) {
-        cout << "check BMC0 failed" << endl;
-        return 1;
-    }
-    if(!check_BMC1()) {
-        cout << "check BMC1 failed" << endl;
-        return 1;
-    }
-
-    // main loop of IC3, start from depth = 1.
-    // Fk need to hold -Bad all the time
-    new_frame();
-    assert(depth() == 1);
-    top_frame_cannot_reach_bad = true;
-    earliest_strengthened_frame = depth();
+int PDR::check(){
     int result = true;
-    int ct = 0;
-    while(true){
-        if(output_stats_for_others)
-            cout<<"\n\n----------------LEVEL "<< depth() << "----------------------\n";
+    try{
+        initialize();
 
-        State *s = new State();
-        // get states which are one step to bad
-        bool flag = get_pre_of_bad(s);
-        if(flag){
-            ++nCTI;
-            obligation_queue.clear();    
-            obligation_queue.insert(Obligation(s, depth()-1, 1));
-            top_frame_cannot_reach_bad = false;
-            if(!rec_block_cube()){
-                // find counter-example
-                result = 1;
-                show_witness();
-                break;
-            }else{
-                for(State *p : states) delete p;
-            }
+        if(!check_BMC0()) {
+            cout << "check BMC0 failed" << endl;
+            return 1;
         }
-        else{
-            assert(obligation_queue.size() == 0);
-            if(output_stats_for_recblock) cout << "CTI not found\n";
-            if(output_stats_for_frames and int(frames.size()) < output_frame_size)  show_frames();
-            if(propagate()){
-                // find invariants
-                result = 0;
-                break;
+        if(!check_BMC1()) {
+            cout << "check BMC1 failed" << endl;
+            return 1;
+        }
+
+        // main loop of IC3, start from depth = 1.
+        // Fk need to hold -Bad all the time
+        new_frame();
+        assert(depth() == 1);
+        top_frame_cannot_reach_bad = true;
+        earliest_strengthened_frame = depth();
+        while(true){
+            if(output_stats_for_others)
+                cout<<"\n\n----------------LEVEL "<< depth() << "----------------------\n";
+
+            State *s = new State();
+            // get states which are one step to bad
+            bool flag = get_pre_of_bad(s);
+            if(flag){
+                ++nCTI;
+                obligation_queue.clear();    
+                obligation_queue.insert(Obligation(s, depth()-1, 1));
+                top_frame_cannot_reach_bad = false;
+                if(!rec_block_cube()){
+                    // find counter-example
+                    result = 1;
+                    show_witness();
+                    break;
+                }else{
+                    for(State *p : states) delete p;
+                }
             }
-            if(output_stats_for_conclusion){
-                cout << ". # Level        " << depth() << endl;
-                cout << ". # Queries:     " << nQuery << endl;
-                cout << ". # CTIs:        " << nCTI << endl;
-                cout << ". # CTGs:        " << nCTG << endl;
-                cout << ". # mic calls:   " << nmic << endl;
-                cout << ". # Red. cores:  " << nCoreReduced << endl;
-                cout << ". # Abort joins: " << nAbortJoin << endl;
-                cout << ". # Abort mics:  " << nAbortMic << endl;
+            else{
+                assert(obligation_queue.size() == 0);
+                if(output_stats_for_recblock) cout << "CTI not found\n";
+                if(output_stats_for_frames and int(frames.size()) < output_frame_size)  show_frames();
+                if(propagate()){
+                    // find invariants
+                    result = 0;
+                    break;
+                }
+                if(output_stats_for_conclusion){
+                    cout << ". # Level        " << depth() << endl;
+                    cout << ". # Queries:     " << nQuery << endl;
+                    cout << ". # CTIs:        " << nCTI << endl;
+                    cout << ". # CTGs:        " << nCTG << endl;
+                    cout << ". # mic calls:   " << nmic << endl;
+                    cout << ". # Red. cores:  " << nCoreReduced << endl;
+                    cout << ". # Abort joins: " << nAbortJoin << endl;
+                    cout << ". # Abort mics:  " << nAbortMic << endl;
+                }
+                new_frame();
+                top_frame_cannot_reach_bad = true;
+                earliest_strengthened_frame = depth();
             }
-            new_frame();
-            top_frame_cannot_reach_bad = true;
-            earliest_strengthened_frame = depth();
         }
+    }catch(Limit_reached &){
+        cout << "c limits reached after " << get_runtime() << "s" << endl;
+        obligation_queue.clear();
+        result = UNDECIDED;
     }
     cout << "depth = " << depth() << endl;
     
-    for(auto f : frames){
-        if(f.solver != nullptr)
-            delete f.solver;
-    }
-    frames.clear();
+    delete_frames();
+
+    show_statistics();
+    return result;
+}
 
+void PDR::show_statistics(){
     cout << "nSkip: " << nSkip << endl;
     cout << "nSafe: " << nSafe << endl;
     cout << "nUnsafe: " << nUnsafe << endl;
@@ -1181,9 +1510,41 @@ bool PDR::check(){
     else
       cout << "Push Rate: 0" << endl;     
 
+    long long nCalls = 0, nPropagated = 0;
+    for(int i=0; i<site_count; ++i){
+        nCalls += sat_profile[i].calls;
+        nPropagated += sat_profile[i].propagated;
+    }
+    cout << "nPropagated: " << nPropagated << endl;
+    if(nCalls) cout << "Propagated Rate: " << float(nPropagated)/nCalls << endl; else cout << "Propagated Rate: 0" << endl;
+
     if(nCube) cout << "Avg lits: " << float(nCubelen) / nCube << endl;  else cout << "Avg lits: 0\n";
     if(nCore) cout << "Avg core len: " << float(nCorelen)/nCore << endl; else cout << "Avg core len: 0\n";
-    return result;
+    if(use_cm){
+        cout << "nCoreMin: " << nCoreMin << endl;
+        cout << "nCoreMinLits: " << nCoreMinLits << endl;
+    }
+}
+
+void PDR::dump_sat_profile(const string &file){
+    static const char *names[site_count] = {"bad", "block", "mic", "ctg", "push", "propagate", "lift", "init", "core"};
+    ofstream out(file);
+    out << "{";
+    for(int i=0; i<site_count; ++i){
+        const Sat_profile &sp = sat_profile[i];
+        out << (i ? "," : "") << "\n  \"" << names[i] << "\": {";
+        out << "\"calls\": " << sp.calls << ", \"sat\": " << sp.sat << ", \"unsat\": " << sp.unsat;
+        out << ", \"propagated\": " << sp.propagated << ", \"seconds\": " << sp.seconds;
+        out << ", \"conflicts\": " << sp.conflicts << ", \"decisions\": " << sp.decisions;
+        out << ", \"propagations\": " << sp.propagations;
+        int n = Sat_profile::nbuckets;
+        while(n > 0 && sp.hist[n-1] == 0) --n;
+        out << ", \"log2_us\": [";
+        for(int b=0; b<n; ++b)
+            out << (b ? ", " : "") << sp.hist[b];
+        out << "]}";
+    }
+    out << "\n}\n";
 }
 
 int PDR::incremental_check(){
@@ -1338,8 +1699,8 @@ bool PDR::rec_block_cube2(){
             show_state(obl.state);
         }
         // check SAT?[Fk /\ -s /\ T /\ s']
-        SATSolver * sat = frames[obl.frame_k].solver;
-        if(is_inductive(sat, obl.frame_k, obl.state->latches, true)){
+        Backend *sat = frames[obl.frame_k].solver;
+        if(is_inductive(sat, obl.frame_k, obl.state->latches, site_block, true)){
             if(output_stats_for_recblock){
                 cout << "the obligation is already fulfilled, and cube is lifted to ";
                 show_litvec(core);
@@ -1356,7 +1717,7 @@ bool PDR::rec_block_cube2(){
             
             int k;
             for(k = obl.frame_k + 1; k<=depth(); ++k){
-                if(!is_inductive(frames[k].solver, k, tmp_core, false)){
+                if(!is_inductive(frames[k].solver, k, tmp_core, site_push, false)){
                     break;
                 }
             }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <fstream>
 #include <vector>
 #include <iostream>
@@ -44,6 +45,27 @@ public:
     And(int o, int i1, int i2):o(o),i1(i1),i2(i2){}
 };
 
+// Appends a compact CNF (0-terminated clauses) for the cone of roots over ands,
+// which must be topologically ordered with positive outputs. MUX/XOR and
+// multi-input AND structures whose inner ands have no other fanout are encoded
+// as a single gate, so those inner ands get no variable. If encoded is given
+// (indexed like ands), ands already marked are skipped and new ones are marked.
+// With polar (Plaisted-Greenbaum) a root l is only encoded for l being true;
+// pass both l and -l for a root that is used in both polarities.
+// An encoder is meant for one ands vector that only grows between calls; its
+// per-variable arrays are kept and reset by bumping an epoch.
+class Cone_encoder{
+    vector<int> pos;            // index in ands of each and output, -1 otherwise
+    size_t npos = 0;            // ands already entered in pos
+    vector<unsigned> stamp;     // refs and pol are only valid where stamp == epoch
+    vector<unsigned> refs;
+    vector<char> pol;
+    unsigned epoch = 0;
+    vector<int> clause, leaves, stack;
+public:
+    void encode(const vector<And> &ands, const vector<int> &roots, vector<int> &cnf, vector<bool> *encoded = nullptr, bool polar = false);
+};
+
 
 // Cone: constraints, bad, latches
 // Real_Init: latches_default /\ constraints
@@ -141,14 +163,45 @@ public:
 };
 
 
+// SAT backend of the frames, lift and init solvers. It is a concrete (final)
+// class, so the hot add / assume / solve calls are not dispatched virtually;
+// switching the backend only needs this typedef changed.
+typedef CaDiCaL Backend;
+
+// call sites of the SAT queries, profiled separately
+enum Sat_site{
+    site_bad,           // get_pre_of_bad
+    site_block,         // is_inductive on a proof obligation
+    site_mic,           // is_inductive while generalizing (CTG_down)
+    site_ctg,           // is_inductive on a counterexample to generalization
+    site_push,          // is_inductive pushing a new lemma / ctg to later frames
+    site_propagate,     // is_inductive in propagate
+    site_lift,          // the lift solve in extract_state_from_sat
+    site_init,          // is_init
+    site_core,          // re-solves of minimize_core
+    site_count
+};
+
+// Wall time of the solves in log2 buckets of microseconds (bucket b counts
+// times in [2^(b-1), 2^b), bucket 0 those below 1us) and the search effort
+// of the solver spent in them.
+class Sat_profile{
+public:
+    static const int nbuckets = 32;
+    long long calls = 0, sat = 0, unsat = 0, propagated = 0;   // propagated: refuted by propagation only
+    long long conflicts = 0, decisions = 0, propagations = 0;
+    double seconds = 0;
+    long long hist[nbuckets] = {};
+};
+
 class Frame{
 public:
     set<Cube, Cube_CMP> cubes;
     set<Cube, Cube_CMP> succ_push; //pp
-    SATSolver *solver = nullptr;
-    Frame(){
-        this->solver = new CaDiCaL();
-        // this->solver = new minisatCore();
+    Backend *solver = nullptr;
+    int act = 0;    // shared solver only: guards the lemmas (I for frame 0), implies act of the next frame
+    Frame(Backend *solver){
+        this->solver = solver;
         cubes.clear();
         succ_push.clear(); //pp
     }
@@ -158,6 +211,8 @@ public:
 class PDR
 {
     Aiger *aiger;
+    Aiger *origin;      // the model as loaded; aiger is its cone of influence
+    vector<unsigned> coi_inputs, coi_latches;   // index in origin of each kept input / latch
     
     // the interal data structure for Aiger (in CNF dimacs format).
     int nInputs, nLatches, nAnds;
@@ -171,20 +226,26 @@ class PDR
     int primed_first_dimacs;
     int property_index;
     bool use_acc, use_pc;
-    map<int, int> map_to_prime, map_to_unprime; // used for mapping ands
+    bool use_pg;    // polarity-aware (Plaisted-Greenbaum) encoding of the cones
+    bool use_ce;    // simplify the translation with CaDiCaL instead of SatELite
+    bool use_ss;    // all frames share one solver holding T once, see new_frame
+    bool use_cm;    // shrink the core of blocking queries (the cube mic starts from), see minimize_core
+    vector<int> map_to_prime, map_to_unprime;   // used for mapping ands, 0 if not primed yet
+    Cone_encoder cone;
     
     // for IC3
-    minisatSimp *satelite = nullptr;
-    CaDiCaL *lift = nullptr;
-    CaDiCaL *init = nullptr;
-    // minisatCore *lift = nullptr;
-    // minisatCore *init = nullptr;
+    vector<int> translation;    // simplified translation (0-terminated clauses) shared by all solvers
+    Backend *trans = nullptr;   // template holding the translation, cloned into fresh solvers
+    Backend *lift = nullptr;
+    Backend *init = nullptr;
 
     State *cex_state_idx = nullptr;
     bool find_cex = false;
     vector<State *> states, cex_states;
 
-    int nSafe, nUnsafe, nSkip, nPush, nUnpush, nCore, nCorelen, nCube, nCubelen;
+    int nSafe, nUnsafe, nSkip, nPush, nUnpush, nCore, nCorelen, nCube, nCubelen, nCoreMin, nCoreMinLits;
+    vector<int> failed;     // failed assumptions of the last query, sorted (load_core)
+    Sat_profile sat_profile[site_count];
 
 public:
     // Frame & Cubes
@@ -199,6 +260,9 @@ public:
     const int option_ctg_tries = 3;
     const int option_ctg_max_depth = 1;
     const int option_max_joins = 1<<20;
+    const int option_ce_effort = 1e7;   // minimum steps per CaDiCaL elimination / subsumption / probing round
+    const int option_propagate_first = 1;   // try propagating the assumptions before solving induction / lift queries
+    const int option_core_min_rounds = 2;   // re-solves per core in minimize_core
     int nQuery, nCTI, nCTG, nmic, nCoreReduced, nAbortJoin, nAbortMic;
 
     heuristic_Lit_CMP* heuristic_lit_cmp = nullptr;
@@ -207,15 +271,16 @@ public:
     // for incremental check
     bool first_incremental_check;
 
-    PDR(Aiger *aiger, int index, bool acc, bool pc): aiger(aiger), property_index(index), use_acc(acc), use_pc(pc){
+    PDR(Aiger *aiger, int index, bool acc, bool pc, bool pg = false, bool ce = false, bool ss = false, bool cm = false): aiger(aiger), origin(aiger), property_index(index), use_acc(acc), use_pc(pc), use_pg(pg), use_ce(ce), use_ss(ss), use_cm(cm){
         start_time = std::chrono::steady_clock::now();
         first_incremental_check = 1;
-        nSafe = nUnsafe = nSkip = nPush = nUnpush = nCore = nCorelen = nCube = nCubelen = 0;
+        nSafe = nUnsafe = nSkip = nPush = nUnpush = nCore = nCorelen = nCube = nCubelen = nCoreMin = nCoreMinLits = 0;
     }
     ~PDR(){
-        if(satelite != nullptr) delete satelite;
+        if(trans != nullptr) delete trans;
         if(lift != nullptr) delete lift;
         if(init != nullptr) delete init;
+        if(aiger != origin) delete aiger;
     }
 
     // Aiger
@@ -226,30 +291,37 @@ public:
     // auxiliary functions
     int prime_var(int var);
     int prime_lit(int lit);
+    int origin_lit(int lit);    // input/latch literal in the numbering of the loaded model
 
 
     // Main IC3/PDR framework
     bool is_init(vector<int> &latches);
-    bool is_inductive(SATSolver *solver, int fi, const Cube &cube, bool gen_core = false, bool reverse_assumption = true);
+    int solve(Backend *solver, Sat_site site, bool propagate_first = false);  // solver->solve(), profiled under site
+    bool is_inductive(Backend *solver, int fi, const Cube &cube, Sat_site site, bool gen_core = false, bool reverse_assumption = true);
+    void load_core(Backend *solver){solver->failed_core(failed); sort(failed.begin(), failed.end());}
+    bool in_core(int lit){return binary_search(failed.begin(), failed.end(), lit);}
+    void minimize_core(Backend *solver, int fi, int act, const Cube &latches, vector<int> assumptions);
     void new_frame();
+    void assume_frame(Backend *solver, int k){if(use_ss) solver->assume(frames[k].act);}
+    void delete_frames();
     bool rec_block_cube();
     bool rec_block_cube2();
     bool propagate();    
     bool get_pre_of_bad(State *s);
-    void extract_state_from_sat(SATSolver *sat, State *s, State *succ);
+    void extract_state_from_sat(Backend *sat, State *s, State *succ);
     void mic(Cube &cube, int k, int depth);
     bool CTG_down(Cube &cube, int k, int depth, set<int> &required);
     void generalize(Cube &cube, int level);
     bool check_BMC0();
     bool check_BMC1();
-    bool check();
+    int check();    // 0 safe, 1 unsafe, UNDECIDED once the limits are reached
     int incremental_check();
     int incremental_check2();
     
 
-    void encode_init_condition(SATSolver *s);   // I
-    void encode_bad_state(SATSolver *s);        // Bad cone, used for test SAT?[I/\-B]
-    void encode_translation(SATSolver *s);      // Latches' Cone + Bad' cone, -Bad must hold
+    void encode_init_condition(Backend *s, int act = 0);   // I, each clause guarded by -act if given
+    void encode_bad_state(Backend *s);        // Bad cone, used for test SAT?[I/\-B]
+    void encode_translation(Backend *s);      // Latches' Cone + Bad' cone, -Bad must hold
     
 
     void clear_po();
@@ -270,6 +342,8 @@ public:
     void show_lit(int l) const;
     void show_litvec(vector<int> &lv) const;
     void show_frames();
+    void show_statistics();
+    void dump_sat_profile(const string &file);    // per call site statistics as JSON
 
 
     //heuristic function
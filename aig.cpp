@@ -6,20 +6,45 @@
 #include <iostream>
 #include <cstring>
 #include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <cstdint>
+#include "sat_solver.hpp"
+#include <zlib.h>
+#include <lzma.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-Aiger_and::Aiger_and(unsigned o, unsigned i1, unsigned i2):
-    o(o),
-    i1(i1),
-    i2(i2)
-{
-}
-
-Aiger_latches::Aiger_latches(unsigned l, unsigned next, unsigned default_val = 0):
-    l(l),
-    next(next),
-    default_val(default_val)
-{
-}
+// binary and sections with at least this many gates are decoded in parallel
+static const unsigned parallel_decode_min_ands = 1 << 18;
+// fraig: 64-bit random and counterexample simulation words per node,
+// candidates tried per node, and SAT effort per query and for the whole pass
+// (in terminator polls, about 10 search steps each)
+static const unsigned fraig_sim_words = 4;
+static const unsigned fraig_cex_words = 4;
+static const unsigned fraig_max_candidates = 4;
+static const unsigned fraig_query_budget = 1000;
+static const unsigned fraig_total_budget = 1 << 20;
+// signal correspondence: simulated frames (64 runs each), and SAT effort per
+// refinement round and for the whole pass
+static const unsigned scorr_sim_frames = 32;
+static const unsigned scorr_query_budget = 1 << 16;
+static const unsigned scorr_total_budget = 1 << 20;
+// rewriting: cuts kept per node, and the largest replacement tree (in ands)
+static const unsigned rewrite_max_cuts = 6;
+static const unsigned rewrite_max_cost = 9;
+// ternary simulation gives up after this many rounds without a fixpoint
+static const unsigned ternary_sim_max_rounds = 256;
 
 Aiger::Aiger(){
     max_var = 0;
@@ -30,13 +55,357 @@ Aiger::Aiger(){
     num_constraints = 0;
     num_latches = 0;
 
-    ands.clear();
-    latches.clear();
-    inputs.clear();
-    outputs.clear();
-    bads.clear();
-    constraints.clear();
-    symbols.clear();
+    num_justice = 0;
+    num_fairness = 0;
+}
+
+Aiger_symbols::Aiger_symbols(){
+    indexed = false;
+}
+
+void Aiger_symbols::build_index(){
+    index.clear();
+    size_t p = 0;
+    while(p < raw.size()){
+        char type = raw[p];
+        size_t q = p + 1;
+        unsigned pos = 0;
+        while(q < raw.size() && raw[q] >= '0' && raw[q] <= '9')
+            pos = pos * 10 + (raw[q++] - '0');
+        index.push_back(make_pair(((unsigned long long)(unsigned char)type << 32) | pos, q + 1));
+        size_t e = raw.find('\n', q);
+        if(e == string::npos) break;
+        p = e + 1;
+    }
+    sort(index.begin(), index.end());
+    indexed = true;
+}
+
+bool Aiger_symbols::has(char type, unsigned pos){
+    if(!indexed) build_index();
+    unsigned long long key = ((unsigned long long)(unsigned char)type << 32) | pos;
+    auto it = lower_bound(index.begin(), index.end(), make_pair(key, (size_t)0));
+    return it != index.end() && it->first == key;
+}
+
+string Aiger_symbols::get(char type, unsigned pos){
+    if(!indexed) build_index();
+    unsigned long long key = ((unsigned long long)(unsigned char)type << 32) | pos;
+    auto it = lower_bound(index.begin(), index.end(), make_pair(key, (size_t)0));
+    if(it == index.end() || it->first != key || it->second > raw.size())
+        return "";
+    size_t e = raw.find('\n', it->second);
+    if(e == string::npos) e = raw.size();
+    return raw.substr(it->second, e - it->second);
+}
+
+// Producer side of a streamed aiger file: reads the raw file on a thread of
+// its own, decompresses it when needed and hands out chunks through a small
+// bounded queue.
+class Aiger_stream{
+public:
+    enum Kind {RAW, GZIP, XZ};
+    static const size_t chunk_size = 1 << 20;
+    static const size_t max_chunks = 4;
+
+    int fd;
+    Kind kind;
+    vector<unsigned char> head;     // bytes already read from fd to detect the kind
+    thread worker;
+    mutex m;
+    condition_variable cv;
+    deque<vector<unsigned char> > chunks;
+    bool done, failed, stop;
+    const char *error;
+
+    Aiger_stream(int fd, Kind kind, const unsigned char *peeked, size_t n):fd(fd),kind(kind),head(peeked, peeked + n),done(false),failed(false),stop(false),error(nullptr){
+        worker = thread(&Aiger_stream::run, this);
+    }
+    ~Aiger_stream(){
+        {
+            lock_guard<mutex> lk(m);
+            stop = true;
+        }
+        cv.notify_all();
+        worker.join();
+        ::close(fd);
+    }
+
+    // blocks while the queue is full; false if the consumer has gone away
+    bool push(vector<unsigned char> &chunk){
+        unique_lock<mutex> lk(m);
+        cv.wait(lk, [this](){ return stop || chunks.size() < max_chunks; });
+        if(stop) return false;
+        chunks.push_back(vector<unsigned char>());
+        chunks.back().swap(chunk);
+        cv.notify_all();
+        return true;
+    }
+
+    // next chunk, or false at the end of the stream
+    bool pop(vector<unsigned char> &chunk){
+        unique_lock<mutex> lk(m);
+        cv.wait(lk, [this](){ return done || !chunks.empty(); });
+        if(chunks.empty()){
+            if(failed){
+                printf("c %s\n", error);
+                exit(1);
+            }
+            return false;
+        }
+        chunk.swap(chunks.front());
+        chunks.pop_front();
+        cv.notify_all();
+        return true;
+    }
+
+    void finish(bool ok, const char *why = "corrupted compressed aiger file"){
+        lock_guard<mutex> lk(m);
+        done = true;
+        failed = !ok;
+        error = why;
+        cv.notify_all();
+    }
+
+    void run(){
+        vector<unsigned char> in(1 << 18), out;
+        out.reserve(chunk_size);
+        bool ok = true;
+        if(kind == RAW){
+            out.assign(head.begin(), head.end());
+            while(true){
+                size_t have = out.size();
+                out.resize(chunk_size);
+                ssize_t n = read(fd, out.data() + have, chunk_size - have);
+                out.resize(have + max<ssize_t>(n, 0));
+                if(n <= 0) break;
+                if(!push(out)) break;
+            }
+        }else if(kind == GZIP){
+            z_stream zs;
+            memset(&zs, 0, sizeof(zs));
+            if(inflateInit2(&zs, 15 + 32) != Z_OK){
+                finish(false, "cannot initialize the gzip decoder");
+                return;
+            }
+            copy(head.begin(), head.end(), in.begin());
+            zs.next_in = in.data();
+            zs.avail_in = head.size();
+            int ret = Z_OK;
+            out.resize(chunk_size);
+            zs.next_out = out.data();
+            zs.avail_out = chunk_size;
+            while(ok){
+                if(zs.avail_in == 0){
+                    ssize_t n = read(fd, in.data(), in.size());
+                    if(n <= 0){
+                        ok = (ret == Z_STREAM_END);
+                        break;
+                    }
+                    zs.next_in = in.data();
+                    zs.avail_in = n;
+                }
+                if(ret == Z_STREAM_END)     // concatenated gzip members
+                    inflateReset(&zs);
+                ret = inflate(&zs, Z_NO_FLUSH);
+                if(ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+                    ok = false;
+                if(zs.avail_out == 0){
+                    if(!push(out)) break;
+                    out.resize(chunk_size);
+                    zs.next_out = out.data();
+                    zs.avail_out = chunk_size;
+                }
+            }
+            out.resize(chunk_size - zs.avail_out);
+            inflateEnd(&zs);
+        }else{
+            lzma_stream xs = LZMA_STREAM_INIT;
+            if(lzma_stream_decoder(&xs, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK){
+                lzma_end(&xs);
+                finish(false, "cannot initialize the xz decoder");
+                return;
+            }
+            copy(head.begin(), head.end(), in.begin());
+            xs.next_in = in.data();
+            xs.avail_in = head.size();
+            lzma_action action = LZMA_RUN;
+            out.resize(chunk_size);
+            xs.next_out = out.data();
+            xs.avail_out = chunk_size;
+            while(ok){
+                if(xs.avail_in == 0 && action == LZMA_RUN){
+                    ssize_t n = read(fd, in.data(), in.size());
+                    if(n <= 0)
+                        action = LZMA_FINISH;
+                    xs.next_in = in.data();
+                    xs.avail_in = (n > 0 ? n : 0);
+                }
+                lzma_ret ret = lzma_code(&xs, action);
+                if(ret == LZMA_STREAM_END){
+                    break;
+                }else if(ret != LZMA_OK){
+                    ok = false;
+                }
+                if(xs.avail_out == 0){
+                    if(!push(out)) break;
+                    out.resize(chunk_size);
+                    xs.next_out = out.data();
+                    xs.avail_out = chunk_size;
+                }
+            }
+            out.resize(chunk_size - xs.avail_out);
+            lzma_end(&xs);
+        }
+        if(ok && !out.empty())
+            push(out);
+        finish(ok);
+    }
+};
+
+Aiger_file::Aiger_file(){
+    buf = nullptr;
+    len = 0;
+    map_len = 0;
+    cap = 0;
+    eof = false;
+    stream = nullptr;
+}
+
+Aiger_file::~Aiger_file(){
+    close();
+}
+
+bool Aiger_file::open(const string &path){
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    // a pipe cannot be rewound, so the bytes peeked at there are handed to
+    // the stream, which consumes them before reading on
+    unsigned char magic[6] = {0};
+    size_t peeked = 0;
+    struct stat st;
+    bool regular = (fstat(fd, &st) == 0 && S_ISREG(st.st_mode));
+    if(regular){
+        ssize_t n = pread(fd, magic, 6, 0);
+        peeked = max<ssize_t>(n, 0);
+    }else{
+        while(peeked < 6){
+            ssize_t n = read(fd, magic + peeked, 6 - peeked);
+            if(n <= 0) break;
+            peeked += n;
+        }
+    }
+    Aiger_stream::Kind kind = Aiger_stream::RAW;
+    if(peeked >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+        kind = Aiger_stream::GZIP;
+    else if(peeked == 6 && memcmp(magic, "\xfd" "7zXZ\0", 6) == 0)
+        kind = Aiger_stream::XZ;
+
+    if(regular && kind == Aiger_stream::RAW && st.st_size > 0){
+        // reserve the file size plus at least Aiger_file::padding zero bytes,
+        // then map the file over the front of the reservation.
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t sz = st.st_size;
+        size_t total = ((sz + padding) / page + 1) * page;
+        void *p = mmap(nullptr, total, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(p != MAP_FAILED){
+            int flags = MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_POPULATE
+            flags |= MAP_POPULATE;
+#endif
+            if(mmap(p, sz, PROT_READ, flags, fd, 0) != MAP_FAILED){
+                madvise(p, sz, MADV_SEQUENTIAL);
+                ::close(fd);
+                buf = (unsigned char *)p;
+                len = sz;
+                map_len = total;
+                eof = true;
+                return true;
+            }
+            munmap(p, total);
+        }
+    }
+
+    // compressed files, pipes and other files that cannot be mapped
+    stream = new Aiger_stream(fd, kind, magic, regular ? 0 : peeked);
+    cap = 2 * Aiger_stream::chunk_size;
+    buf = (unsigned char *)malloc(cap + padding);
+    if(buf == nullptr){
+        close();
+        return false;
+    }
+    memset(buf, 0, padding);
+    unsigned char *pos = buf;
+    refill(pos);
+    return true;
+}
+
+void Aiger_file::close(){
+    if(stream != nullptr){
+        delete stream;
+        stream = nullptr;
+    }
+    if(buf == nullptr) return;
+    if(map_len)
+        munmap(buf, map_len);
+    else
+        free(buf);
+    buf = nullptr;
+    len = 0;
+    map_len = 0;
+    cap = 0;
+    eof = false;
+}
+
+// drop the data before pos and append the next chunk of the stream
+bool Aiger_file::refill(unsigned char *&pos){
+    if(eof) return false;
+    vector<unsigned char> chunk;
+    if(!stream->pop(chunk)){
+        eof = true;
+        return false;
+    }
+    size_t keep = buf + len - pos;
+    if(pos != buf)
+        memmove(buf, pos, keep);
+    if(keep + chunk.size() > cap){
+        size_t grown = max(2 * cap, keep + chunk.size());
+        unsigned char *p = (unsigned char *)realloc(buf, grown + padding);
+        if(p == nullptr){
+            printf("c out of memory reading aiger file\n");
+            exit(1);
+        }
+        buf = p;
+        cap = grown;
+    }
+    memcpy(buf + keep, chunk.data(), chunk.size());
+    len = keep + chunk.size();
+    memset(buf + len, 0, padding);
+    pos = buf;
+    return true;
+}
+
+void Aiger_file::ensure(unsigned char *&pos, size_t n){
+    while(!eof && (size_t)(buf + len - pos) < n)
+        refill(pos);
+}
+
+void Aiger_file::ensure_lines(unsigned char *&pos, size_t lines){
+    size_t seen = 0, scanned = 0;
+    while(!eof){
+        unsigned char *p = pos + scanned, *e = buf + len;
+        while(seen < lines && p < e){
+            p = (unsigned char *)memchr(p, '\n', e - p);
+            if(p == nullptr) break;
+            ++seen;
+            ++p;
+        }
+        if(seen >= lines) return;
+        scanned = e - pos;
+        refill(pos);
+    }
 }
 
 int read_literal(unsigned char **fbuf){
@@ -56,6 +425,123 @@ int read_literal(unsigned char **fbuf){
     return result;
 }
 
+#ifdef __SSE2__
+// value of the n (1..8) decimal digits at p, converted within one 64-bit word
+static inline unsigned parse_digits(const unsigned char *p, unsigned n){
+    uint64_t v;
+    memcpy(&v, p, 8);
+    v <<= 8 * (8 - n);
+    v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    v = ((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+    return (unsigned)v;
+}
+
+static inline unsigned digit_mask(__m128i v){
+    return _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                           _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1))));
+}
+
+static inline unsigned stop_mask(__m128i v){
+    return _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                          _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+}
+#endif
+
+// read the numbers on the current line into vals (at most max of them), move
+// to the beginning of the next line and return how many numbers were found.
+// Lines are classified 32 bytes at a time, and every number in the window is
+// taken from the digit mask, so the buffer has to be padded as in Aiger_file.
+int read_line(unsigned char **fbuf, unsigned *vals, int max){
+    unsigned char *p = *fbuf;
+    int cnt = 0;
+#ifdef __SSE2__
+    while(true){
+        __m128i a = _mm_loadu_si128((const __m128i *)p);
+        __m128i b = _mm_loadu_si128((const __m128i *)(p + 16));
+        unsigned digits = digit_mask(a) | (digit_mask(b) << 16);
+        unsigned stops = stop_mask(a) | (stop_mask(b) << 16);
+        unsigned lim = (stops ? __builtin_ctz(stops) : 32);
+        if(lim < 32) digits &= (1u << lim) - 1;
+        while(digits){
+            unsigned st = __builtin_ctz(digits);
+            unsigned rest = ~(digits >> st);
+            unsigned n = (rest ? __builtin_ctz(rest) : 32);
+            if(lim == 32 && st + n == 32 && st > 0)
+                break;      // the number may continue in the next window
+            assert(n <= 10);
+            unsigned v = (n <= 8 ? parse_digits(p + st, n)
+                : parse_digits(p + st, n - 8) * 100000000u + parse_digits(p + st + n - 8, 8));
+            if(cnt < max) vals[cnt] = v;
+            ++cnt;
+            digits &= ~((n < 32 ? (1u << n) - 1 : ~0u) << st);
+        }
+        if(lim < 32){
+            p += lim;
+            if(*p == '\n') ++p;
+            break;
+        }
+        p += (digits ? __builtin_ctz(digits) : 32);
+    }
+#else
+    while(*p != '\n' && *p != 0){
+        if(*p < '0' || *p > '9'){ ++p; continue; }
+        unsigned v = 0;
+        while(*p >= '0' && *p <= '9')
+            v = v * 10 + (*p++ - '0');
+        if(cnt < max) vals[cnt] = v;
+        ++cnt;
+    }
+    if(*p == '\n') ++p;
+#endif
+    *fbuf = p;
+    return cnt;
+}
+
+// read the next count numbers into vals, whatever lines they are on, and stop
+// right after the last one. Used for the sections whose lines all hold the
+// same number of literals; 64 bytes are classified at a time.
+void read_numbers(unsigned char **fbuf, unsigned *vals, size_t count){
+    unsigned char *p = *fbuf;
+    size_t cnt = 0;
+#ifdef __SSE2__
+    while(cnt < count){
+        uint64_t digits = 0;
+        for(int k=0; k<4; ++k)
+            digits |= (uint64_t)digit_mask(_mm_loadu_si128((const __m128i *)(p + 16 * k))) << (16 * k);
+        unsigned char *next = p + 64;
+        while(digits && cnt < count){
+            unsigned st = __builtin_ctzll(digits);
+            uint64_t rest = ~(digits >> st);
+            unsigned n = (rest ? __builtin_ctzll(rest) : 64);
+            if(st + n == 64 && st > 0){
+                next = p + st;      // the number may continue in the next window
+                break;
+            }
+            assert(n <= 10);
+            vals[cnt++] = (n <= 8 ? parse_digits(p + st, n)
+                : parse_digits(p + st, n - 8) * 100000000u + parse_digits(p + st + n - 8, 8));
+            next = p + st + n;
+            digits &= ~((n < 64 ? (1ull << n) - 1 : ~0ull) << st);
+        }
+        if(cnt < count && !digits)
+            next = p + 64;
+        p = next;
+        if(cnt < count && *p == 0 && p[-1] == 0)
+            break;      // truncated file
+    }
+#else
+    while(cnt < count && *p != 0){
+        if(*p < '0' || *p > '9'){ ++p; continue; }
+        unsigned v = 0;
+        while(*p >= '0' && *p <= '9')
+            v = v * 10 + (*p++ - '0');
+        vals[cnt++] = v;
+    }
+#endif
+    assert(cnt == count);
+    *fbuf = p;
+}
 
 unsigned decode(unsigned char **fbuf){
     unsigned x = 0, i = 0;
@@ -66,6 +552,86 @@ unsigned decode(unsigned char **fbuf){
     return x | (ch << (7 * i));
 }
 
+// number of varint terminators (bytes with the high bit clear) in [p, e)
+static size_t count_varint_ends(const unsigned char *p, const unsigned char *e){
+    size_t n = 0;
+#ifdef __SSE2__
+    for(; p + 16 <= e; p += 16){
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        n += 16 - __builtin_popcount(_mm_movemask_epi8(v));
+    }
+#endif
+    for(; p < e; ++p)
+        n += (*p < 0x80);
+    return n;
+}
+
+static void decode_ands(Aiger *aiger, unsigned char *fbuf, unsigned begin, unsigned end, unsigned char **stop){
+    for(unsigned i=begin; i<end; ++i){
+        unsigned o  = aiger->and_lit(i);
+        unsigned i1 = o  - decode(&fbuf);
+        unsigned i2 = i1 - decode(&fbuf);
+        aiger->and_i1[i] = i1;
+        aiger->and_i2[i] = i2;
+    }
+    *stop = fbuf;
+}
+
+// Decode the binary and section starting at fbuf with several threads and
+// return the position right after it. Every gate is two varints and its
+// output literal follows from its index, so once the byte offset of a gate
+// is known the rest of the section can be decoded independently:
+//   1. count the varint terminators in equal byte chunks,
+//   2. move each chunk start forward to the next gate boundary, whose index
+//      is half the number of terminators before it,
+//   3. decode the gate ranges between consecutive boundaries.
+static unsigned char *decode_ands_parallel(Aiger *aiger, unsigned char *fbuf, unsigned char *fend, unsigned nthreads){
+    size_t need = 2 * (size_t)aiger->num_ands;
+    // a 32-bit varint takes at most 5 bytes
+    unsigned char *end = fbuf + min((size_t)(fend - fbuf), 5 * need);
+
+    vector<unsigned char *> bounds(nthreads + 1);
+    for(unsigned t=0; t<nthreads; ++t)
+        bounds[t] = fbuf + (end - fbuf) * t / nthreads;
+    bounds[nthreads] = end;
+
+    vector<size_t> counts(nthreads);
+    vector<thread> workers;
+    for(unsigned t=0; t<nthreads; ++t)
+        workers.push_back(thread([&, t](){ counts[t] = count_varint_ends(bounds[t], bounds[t+1]); }));
+    for(thread &w : workers) w.join();
+    workers.clear();
+
+    vector<unsigned> first_gate(nthreads + 1, aiger->num_ands);
+    vector<unsigned char *> first_pos(nthreads + 1, end);
+    size_t before = 0;
+    for(unsigned t=0; t<nthreads; ++t){
+        unsigned char *p = bounds[t];
+        size_t ends = before;
+        while(ends < need && p < end && !((p == fbuf || p[-1] < 0x80) && ends % 2 == 0)){
+            ends += (*p < 0x80);
+            ++p;
+        }
+        if(ends < need && p < end){
+            first_gate[t] = ends / 2;
+            first_pos[t] = p;
+        }
+        before += counts[t];
+    }
+    assert(before >= need);
+
+    vector<unsigned char *> stops(nthreads, nullptr);
+    for(unsigned t=0; t<nthreads; ++t){
+        if(first_gate[t] < first_gate[t+1])
+            workers.push_back(thread(decode_ands, aiger, first_pos[t], first_gate[t], first_gate[t+1], &stops[t]));
+    }
+    for(thread &w : workers) w.join();
+
+    for(unsigned t=nthreads; t-- > 0;)
+        if(stops[t] != nullptr) return stops[t];
+    return fbuf;
+}
+
 void encode (string& str, unsigned x)
 {
     unsigned char ch;
@@ -82,15 +648,13 @@ void encode (string& str, unsigned x)
 Aiger* load_aiger_from_file(string str){
     Aiger *aiger = new Aiger;
     
-    ifstream fin(str);
-    fin.seekg(0, ios::end);
-    int len = fin.tellg();
-    fin.seekg(0, ios::beg);
-    char *tbuf = new char[len+1];
-    fin.read(tbuf, len);
-    tbuf[len] = 0;
-    unsigned char *fbuf = (unsigned char *)tbuf;
-    fin.close();
+    Aiger_file file;
+    if(!file.open(str) || file.len == 0){
+        printf("c cannot read aiger file %s\n", str.c_str());
+        exit(1);
+    }
+    unsigned char *fbuf = file.buf;
+    file.ensure_lines(fbuf, 1);
 
     bool binary_mode = false;
     assert(*fbuf == 'a');
@@ -115,48 +679,65 @@ Aiger* load_aiger_from_file(string str){
     
 
     assert(aiger->max_var == (aiger->num_inputs + aiger->num_latches + aiger->num_ands));
-    
+    read_literal(&fbuf); fbuf++;
+
+    // the remaining ascii lines are read by read_numbers, or by read_line when
+    // the number of literals on a line varies. Both work on blocks of lines
+    // that have been made available in the file window.
+    const unsigned block = 4096;
+    unsigned vals[3];
+    int cnt;
+    auto read_section = [&](unsigned *dst, unsigned lines, unsigned per_line){
+        for(unsigned i=0; i<lines; i+=block){
+            unsigned n = min(block, lines - i);
+            file.ensure_lines(fbuf, n);
+            read_numbers(&fbuf, dst + (size_t)i * per_line, (size_t)n * per_line);
+            read_line(&fbuf, vals, 0);
+        }
+    };
+
+    aiger->inputs.reserve(aiger->num_inputs);
+    aiger->latch_next.resize(aiger->num_latches);
+    aiger->latch_default.resize(aiger->num_latches);
+    aiger->and_i1.resize(aiger->num_ands);
+    aiger->and_i2.resize(aiger->num_ands);
 
     if(binary_mode){
-        for(int i=1; i<=aiger->num_inputs; ++i)
+        for(unsigned i=1; i<=aiger->num_inputs; ++i)
             aiger->inputs.push_back(2*i);
     }else{
-        for(int i=0; i<aiger->num_inputs; ++i){
-            read_literal(&fbuf); fbuf++;
-            aiger->inputs.push_back(read_literal(&fbuf));
-        }
+        aiger->inputs.resize(aiger->num_inputs);
+        read_section(aiger->inputs.data(), aiger->num_inputs, 1);
     }
 
-    for(int i=0; i<aiger->num_latches; ++i){
+    for(unsigned i=0; i<aiger->num_latches; ++i){
         int l, n, d;
-        read_literal(&fbuf); fbuf++;
+        file.ensure_lines(fbuf, 1);
         if(binary_mode){
-            l = 2 * (aiger->num_inputs + 1 + i);
+            l = aiger->latch_lit(i);
+            cnt = read_line(&fbuf, vals + 1, 2) + 1;
         }else{
-            l = read_literal(&fbuf);
+            cnt = read_line(&fbuf, vals, 3);
+            l = vals[0];
+            assert((unsigned)l == aiger->latch_lit(i));
         }
-        n = read_literal(&fbuf);
-        d = max(read_literal(&fbuf), 0);
+        n = vals[1];
+        d = (cnt > 2 ? vals[2] : 0);
         // 0: reset; 1: set;  d=l: uninitialized
-        aiger->latches.push_back(Aiger_latches(l, n, d));
+        aiger->latch_next[i] = n;
+        aiger->latch_default[i] = d;
         if(aig_veb == 2)
             printf("c read latches %d <- %d (default %d)\n", l, n, d);
     }
 
-    for(int i=0; i<aiger->num_outputs; ++i){
-        read_literal(&fbuf); fbuf++;
-        aiger->outputs.push_back(read_literal(&fbuf));
-    }
+    aiger->outputs.resize(aiger->num_outputs);
+    read_section(aiger->outputs.data(), aiger->num_outputs, 1);
 
-    for(int i=0; i<aiger->num_bads; ++i){
-        read_literal(&fbuf); fbuf++;
-        aiger->bads.push_back(read_literal(&fbuf));
-    }
+    aiger->bads.resize(aiger->num_bads);
+    read_section(aiger->bads.data(), aiger->num_bads, 1);
 
-    for(int i=0; i<aiger->num_constraints; ++i){
-        read_literal(&fbuf); fbuf++;
-        (aiger->constraints).push_back(read_literal(&fbuf));
-    }
+    aiger->constraints.resize(aiger->num_constraints);
+    read_section(aiger->constraints.data(), aiger->num_constraints, 1);
 
     //cout << "initial constraints.size = " << (aiger->constraints).size() << endl;
     // // sort((aiger->constraints).begin(),(aiger->constraints).end());
@@ -173,89 +754,71 @@ Aiger* load_aiger_from_file(string str){
     
     // TODO: finish justice and fairness
 
-    if(binary_mode){
-        read_literal(&fbuf);fbuf++;
+    unsigned nthreads = min(thread::hardware_concurrency(), 16u);
+    if(binary_mode && file.eof && aiger->num_ands >= parallel_decode_min_ands && nthreads > 1 && aig_veb < 2){
+        fbuf = decode_ands_parallel(aiger, fbuf, file.buf + file.len, nthreads);
+    }else if(binary_mode){
         int o, i1, i2, d1, d2;
-        for(int i=0; i<aiger->num_ands; ++i){
-            o  = 2 * (aiger->num_inputs + aiger->num_latches + i + 1);
+        for(unsigned i=0; i<aiger->num_ands; ++i){
+            if(i % block == 0)
+                file.ensure(fbuf, 10 * block);  // two varints of at most 5 bytes per gate
+            o  = aiger->and_lit(i);
             d1 = decode(&fbuf);
             i1 = o  - d1;
             d2 = decode(&fbuf);
             i2 = i1 - d2;
-            aiger->ands.push_back(Aiger_and(o, i1, i2));
+            aiger->and_i1[i] = i1;
+            aiger->and_i2[i] = i2;
             if(aig_veb == 2)
                 printf("c read and %d <- %d, %d\n", o, i1, i2);
         }
 
     }else{
-        int o, i1, i2;
-        for(int i=0; i<aiger->num_ands; ++i){
-            read_literal(&fbuf); fbuf++;
-            o = read_literal(&fbuf);
-            i1 = read_literal(&fbuf);
-            i2 = read_literal(&fbuf);
-            aiger->ands.push_back(Aiger_and(o, i1, i2));
-            if(aig_veb == 2)
-                printf("c read and %d <- %d, %d\n", o, i1, i2);
+        // 3 literals per line, decoded in blocks
+        vector<unsigned> lits(3 * block);
+        for(unsigned i=0; i<aiger->num_ands; i+=block){
+            unsigned n = min(block, aiger->num_ands - i);
+            file.ensure_lines(fbuf, n);
+            read_numbers(&fbuf, lits.data(), 3 * n);
+            read_line(&fbuf, vals, 0);
+            for(unsigned j=0; j<n; ++j){
+                assert(lits[3*j] == aiger->and_lit(i+j));
+                aiger->and_i1[i+j] = lits[3*j+1];
+                aiger->and_i2[i+j] = lits[3*j+2];
+                if(aig_veb == 2)
+                    printf("c read and %d <- %d, %d\n", lits[3*j], lits[3*j+1], lits[3*j+2]);
+            }
         }
-
     }
 
-    // read symbols
-    string tstr;
+    // the rest of the file is small compared to the and section
+    file.ensure(fbuf, SIZE_MAX);
+    unsigned char *fend = file.buf + file.len;
+
+    // read symbols: keep the raw section up to the comment marker and leave
+    // the decoding to Aiger_symbols
+    unsigned char *sym_begin = fbuf;
     bool comments = false;
-    if(!binary_mode)
-        while(*fbuf != '\n') {fbuf++;}
-    if((char *)fbuf - tbuf < len-1){
-        if(binary_mode) fbuf--;
-        while(true){
-            fbuf++;
-            tstr = "";
-            if(*fbuf == 'i'){
-                int v = read_literal(&fbuf);
-                fbuf++;
-                while(*fbuf != '\n'){
-                    tstr += *fbuf;
-                    fbuf++;
-                }
-                aiger->symbols[v] = tstr;
-                if(aig_veb == 2)
-                    cout << "i" << v << " " << tstr << endl;
-            }else if(*fbuf == 'l'){
-                int v = read_literal(&fbuf);
-                fbuf++;
-                while(*fbuf != '\n'){
-                    tstr += *fbuf;
-                    fbuf++;
-                }
-                aiger->symbols[v] = tstr;
-                if(aig_veb == 2)
-                    cout<< "l" << v<<" "<<tstr<<endl;
-            }else if(*fbuf == 'o'){
-                int v = read_literal(&fbuf);
-                fbuf++;
-                while(*fbuf != '\n'){
-                    tstr += *fbuf;
-                    fbuf++;
-                }
-                aiger->symbols[v] = tstr;
-                if(aig_veb == 2)
-                    cout<<"o"<<v<<" "<<tstr<<endl;
-            }else if(*fbuf == 'c'){
-                comments = true;
-                fbuf++;
-                break;
-            }else{
-                break;
-            }
+    while(fbuf < fend){
+        if(*fbuf == 'c' && (fbuf + 1 == fend || fbuf[1] == '\n')){
+            comments = true;
+            break;
         }
+        if(*fbuf != 'i' && *fbuf != 'l' && *fbuf != 'o' && *fbuf != 'b'
+            && *fbuf != 'c' && *fbuf != 'j' && *fbuf != 'f')
+            break;
+        unsigned char *e = (unsigned char *)memchr(fbuf, '\n', fend - fbuf);
+        fbuf = (e == nullptr ? fend : e + 1);
     }
+    aiger->symbols.raw.assign((char *)sym_begin, fbuf - sym_begin);
+    if(aig_veb == 2)
+        cout << aiger->symbols.raw;
 
     aiger->comments = "";
     if(comments){
-        assert(*fbuf == '\n');
         fbuf++;
-        aiger->comments = string((char*)fbuf);
+        if(fbuf < fend && *fbuf == '\n') fbuf++;
+        aiger->comments.assign((char *)fbuf, fend - fbuf);
         if(aig_veb == 2)
             cout<<aiger->comments<<endl;
     }    
@@ -272,4 +835,861 @@ Aiger* load_aiger_from_file(string str){
             , aiger->num_fairness);
     }
     return aiger;
-}
\ No newline at end of file
+}
+// structurally hashed and section under construction. Ands are numbered from
+// first_and in creation order with i1 > i2; constants and a&a, a&!a are folded.
+class Strash_table{
+public:
+    static const uint32_t none = UINT32_MAX;
+    unsigned first_and;
+    vector<uint32_t> i1, i2;
+
+    Strash_table(unsigned first_and, size_t capacity);
+    uint32_t find(uint32_t a, uint32_t b);  // literal of a & b, none if it needs a new and
+    uint32_t make(uint32_t a, uint32_t b);
+
+private:
+    // open addressing on (a, b); key 0 is free since b > 1 for every stored and
+    vector<uint64_t> keys;
+    vector<uint32_t> vals;
+    size_t mask;
+    size_t slot(uint64_t key) const;
+    void grow();
+};
+
+Strash_table::Strash_table(unsigned first_and, size_t capacity): first_and(first_and){
+    i1.reserve(capacity);
+    i2.reserve(capacity);
+    mask = 1;
+    while(mask < 2 * capacity) mask <<= 1;
+    keys.assign(mask, 0);
+    vals.resize(mask);
+    mask -= 1;
+}
+
+size_t Strash_table::slot(uint64_t key) const{
+    size_t h = (key * 0x9E3779B97F4A7C15ull) >> 20 & mask;
+    while(keys[h] != 0 && keys[h] != key)
+        h = (h + 1) & mask;
+    return h;
+}
+
+void Strash_table::grow(){
+    vector<uint64_t> old_keys;
+    vector<uint32_t> old_vals;
+    old_keys.swap(keys);
+    old_vals.swap(vals);
+    mask = 2 * (mask + 1);
+    keys.assign(mask, 0);
+    vals.resize(mask);
+    mask -= 1;
+    for(size_t h=0; h<old_keys.size(); ++h){
+        if(old_keys[h] == 0) continue;
+        size_t t = slot(old_keys[h]);
+        keys[t] = old_keys[h];
+        vals[t] = old_vals[h];
+    }
+}
+
+uint32_t Strash_table::find(uint32_t a, uint32_t b){
+    if(a < b) swap(a, b);
+    if(b == 0 || a == (b ^ 1)) return 0;
+    if(b == 1 || a == b) return a;
+    size_t h = slot((uint64_t(a) << 32) | b);
+    return keys[h] ? vals[h] : none;
+}
+
+uint32_t Strash_table::make(uint32_t a, uint32_t b){
+    if(a < b) swap(a, b);
+    if(b == 0 || a == (b ^ 1)) return 0;
+    if(b == 1 || a == b) return a;
+    uint64_t key = (uint64_t(a) << 32) | b;
+    size_t h = slot(key);
+    if(keys[h])
+        return vals[h];
+    if(2 * (i1.size() + 1) > mask){
+        grow();
+        h = slot(key);
+    }
+    uint32_t res = 2 * (first_and + i1.size());
+    keys[h] = key;
+    vals[h] = res;
+    i1.push_back(a);
+    i2.push_back(b);
+    return res;
+}
+
+// replace the latch next states, outputs, bads and constraints by map
+static void map_roots(Aiger *aiger, const vector<uint32_t> &map){
+    auto map_lit = [&](uint32_t lit){return map[lit >> 1] ^ (lit & 1);};
+    for(uint32_t &l : aiger->latch_next) l = map_lit(l);
+    for(unsigned &l : aiger->outputs) l = map_lit(l);
+    for(unsigned &l : aiger->bads) l = map_lit(l);
+    for(unsigned &l : aiger->constraints) l = map_lit(l);
+}
+
+void strash_aiger(Aiger *aiger){
+    unsigned I = aiger->num_inputs, L = aiger->num_latches, A = aiger->num_ands;
+    unsigned first_and = I + L + 1;
+
+    // map[v]: literal of old variable v after hashing, new ands numbered from first_and
+    vector<uint32_t> map(first_and + A);
+    for(unsigned v=0; v<first_and; ++v)
+        map[v] = 2 * v;
+    auto map_lit = [&](uint32_t lit){return map[lit >> 1] ^ (lit & 1);};
+
+    Strash_table table(first_and, A);
+    for(unsigned k=0; k<A; ++k){
+        assert(aiger->and_i1[k] < aiger->and_lit(k) && aiger->and_i2[k] < aiger->and_lit(k));
+        map[first_and + k] = table.make(map_lit(aiger->and_i1[k]), map_lit(aiger->and_i2[k]));
+    }
+    vector<uint32_t> i1, i2;
+    i1.swap(table.i1);
+    i2.swap(table.i2);
+    map_roots(aiger, map);
+
+    // drop the ands nothing depends on
+    unsigned n = i1.size();
+    vector<char> used(n, 0);
+    auto use = [&](uint32_t lit){if((lit >> 1) >= first_and) used[(lit >> 1) - first_and] = 1;};
+    for(uint32_t l : aiger->latch_next) use(l);
+    for(unsigned l : aiger->outputs) use(l);
+    for(unsigned l : aiger->bads) use(l);
+    for(unsigned l : aiger->constraints) use(l);
+    for(unsigned k=n; k-- > 0;){
+        if(!used[k]) continue;
+        use(i1[k]);
+        use(i2[k]);
+    }
+    vector<uint32_t> compact(first_and + n);
+    for(unsigned v=0; v<first_and; ++v)
+        compact[v] = 2 * v;
+    unsigned m = 0;
+    for(unsigned k=0; k<n; ++k){
+        if(!used[k]) continue;
+        compact[first_and + k] = 2 * (first_and + m);
+        i1[m] = compact[i1[k] >> 1] ^ (i1[k] & 1);
+        i2[m] = compact[i2[k] >> 1] ^ (i2[k] & 1);
+        ++m;
+    }
+    i1.resize(m);
+    i2.resize(m);
+    map_roots(aiger, compact);
+
+    if(aig_veb)
+        printf("c strash: ands %u -> %u\n", A, m);
+    aiger->and_i1.swap(i1);
+    aiger->and_i2.swap(i2);
+    aiger->num_ands = m;
+    aiger->max_var = I + L + m;
+}
+
+// ternary values: 0, 1, X = 2. Negation maps 0 <-> 1 and keeps X.
+static inline uint8_t ternary_lit(const vector<uint8_t> &val, uint32_t lit){
+    uint8_t v = val[lit >> 1];
+    return (v == 2) ? 2 : (v ^ (lit & 1));
+}
+
+unsigned remove_stuck_latches(Aiger *aiger){
+    unsigned I = aiger->num_inputs, L = aiger->num_latches, A = aiger->num_ands;
+    vector<uint8_t> val(1 + I + L + A, 2);
+    val[0] = 0;
+    for(unsigned i=0; i<L; ++i){
+        uint32_t d = aiger->latch_default[i];
+        val[1 + I + i] = (d <= 1 ? d : 2);
+    }
+
+    // every round joins the successor into the current latch values, which
+    // only ever turns constants into X, so a fixpoint is reached in <= L+1 rounds
+    bool fixpoint = false;
+    for(unsigned round=0; round<ternary_sim_max_rounds && !fixpoint; ++round){
+        for(unsigned k=0; k<A; ++k){
+            uint8_t a = ternary_lit(val, aiger->and_i1[k]);
+            uint8_t b = ternary_lit(val, aiger->and_i2[k]);
+            val[1 + I + L + k] = (a == 0 || b == 0) ? 0 : ((a == 1 && b == 1) ? 1 : 2);
+        }
+        fixpoint = true;
+        for(unsigned i=0; i<L; ++i){
+            uint8_t &cur = val[1 + I + i];
+            uint8_t next = ternary_lit(val, aiger->latch_next[i]);
+            if(cur != 2 && cur != next){
+                cur = 2;
+                fixpoint = false;
+            }
+        }
+    }
+    if(!fixpoint)
+        return 0;
+
+    vector<uint32_t> subst(1 + I + L + A);
+    unsigned n = 0;
+    for(unsigned v=0; v<subst.size(); ++v)
+        subst[v] = 2 * v;
+    for(unsigned i=0; i<L; ++i){
+        uint8_t c = val[1 + I + i];
+        if(c == 2) continue;
+        subst[1 + I + i] = c;
+        aiger->latch_next[i] = c;
+        ++n;
+    }
+    if(n == 0)
+        return 0;
+    auto subst_lit = [&](uint32_t lit){return subst[lit >> 1] ^ (lit & 1);};
+    for(unsigned k=0; k<A; ++k){
+        aiger->and_i1[k] = subst_lit(aiger->and_i1[k]);
+        aiger->and_i2[k] = subst_lit(aiger->and_i2[k]);
+    }
+    map_roots(aiger, subst);
+    strash_aiger(aiger);
+    return n;
+}
+
+// counts down the effort left in *state, see CaDiCaL::set_terminate; the
+// global limits still apply
+static int budget_terminate(void *state){
+    unsigned *left = (unsigned *)state;
+    if(*left == 0 || limits.exceeded())
+        return 1;
+    --*left;
+    return 0;
+}
+
+// simulate words [w0, w1) of every and, sim holds W words per node
+static void simulate_ands(const Aiger *aiger, vector<uint64_t> &sim, unsigned W, unsigned w0, unsigned w1){
+    unsigned first_and = aiger->num_inputs + aiger->num_latches + 1;
+    for(unsigned k=0; k<aiger->num_ands; ++k){
+        uint32_t a = aiger->and_i1[k], b = aiger->and_i2[k];
+        const uint64_t *pa = &sim[(size_t)(a >> 1) * W], *pb = &sim[(size_t)(b >> 1) * W];
+        uint64_t ma = -(uint64_t)(a & 1), mb = -(uint64_t)(b & 1);
+        uint64_t *po = &sim[(size_t)(first_and + k) * W];
+        for(unsigned w=w0; w<w1; ++w)
+            po[w] = (pa[w] ^ ma) & (pb[w] ^ mb);
+    }
+}
+
+unsigned fraig_aiger(Aiger *aiger){
+    // per node: fraig_sim_words random words, then fraig_cex_words words of
+    // counterexamples from failed proofs, refilled round-robin
+    const unsigned R = fraig_sim_words, W = fraig_sim_words + fraig_cex_words;
+    unsigned I = aiger->num_inputs, L = aiger->num_latches, A = aiger->num_ands;
+    unsigned first_and = I + L + 1, N = first_and + A;
+
+    vector<uint64_t> sim((size_t)N * W, 0);
+    uint64_t rnd = 0x2545F4914F6CDD1Dull;
+    for(unsigned v=1; v<first_and; ++v){
+        for(unsigned w=0; w<R; ++w){
+            rnd ^= rnd << 13; rnd ^= rnd >> 7; rnd ^= rnd << 17;
+            sim[(size_t)v * W + w] = rnd;
+        }
+    }
+    simulate_ands(aiger, sim, W, 0, W);
+
+    // classes by the random words; candidates must also agree on the
+    // counterexample words. Both are compared up to complement.
+    auto phase = [&](unsigned v){return (unsigned)(sim[(size_t)v * W] & 1);};
+    auto sig_hash = [&](unsigned v){
+        const uint64_t *p = &sim[(size_t)v * W];
+        uint64_t m = -(p[0] & 1), h = 0;
+        for(unsigned w=0; w<R; ++w)
+            h = (h ^ (p[w] ^ m)) * 0x9E3779B97F4A7C15ull;
+        return h;
+    };
+    auto same_sig = [&](unsigned u, unsigned v){
+        const uint64_t *p = &sim[(size_t)u * W], *q = &sim[(size_t)v * W];
+        uint64_t m = -((p[0] ^ q[0]) & 1);
+        for(unsigned w=0; w<W; ++w)
+            if(p[w] != (q[w] ^ m)) return false;
+        return true;
+    };
+    unordered_map<uint64_t, vector<unsigned> > classes;
+    for(unsigned v=0; v<first_and; ++v)
+        classes[sig_hash(v)].push_back(v);
+
+    // node v is dimacs variable v+1, the constant is false
+    CaDiCaL solver;
+    unsigned budget = 0, total = fraig_total_budget;
+    solver.set_terminate(&budget, budget_terminate);
+    solver.add(-1); solver.add(0);
+    vector<char> encoded(first_and, 1);
+    encoded.resize(N, 0);
+    vector<unsigned> todo;
+    auto encode = [&](unsigned root){
+        if(encoded[root]) return;
+        todo.push_back(root);
+        while(!todo.empty()){
+            unsigned v = todo.back();
+            unsigned k = v - first_and;
+            uint32_t a = aiger->and_i1[k], b = aiger->and_i2[k];
+            if(!encoded[a >> 1]){todo.push_back(a >> 1); continue;}
+            if(!encoded[b >> 1]){todo.push_back(b >> 1); continue;}
+            todo.pop_back();
+            if(encoded[v]) continue;
+            encoded[v] = 1;
+            int o = v + 1, da = aiger_to_dimacs(a), db = aiger_to_dimacs(b);
+            solver.add(-o); solver.add(da); solver.add(0);
+            solver.add(-o); solver.add(db); solver.add(0);
+            solver.add(o); solver.add(-da); solver.add(-db); solver.add(0);
+        }
+    };
+
+    // counterexamples are collected bit by bit in the next cex word of the
+    // inputs and latches, then simulated through all ands at once
+    unsigned cex_word = R, cex_bits = 0;
+    auto add_cex = [&](){
+        for(unsigned v=1; v<first_and; ++v){
+            uint64_t &w = sim[(size_t)v * W + cex_word];
+            uint64_t bit = (v + 1 <= (unsigned)solver.max_var() && solver.val(v + 1) > 0);
+            w = (w & ~(1ull << cex_bits)) | (bit << cex_bits);
+        }
+        if(++cex_bits == 64){
+            simulate_ands(aiger, sim, W, cex_word, cex_word + 1);
+            cex_bits = 0;
+            cex_word = (cex_word + 1 == W) ? R : cex_word + 1;
+        }
+    };
+
+    // v == c ^ p ? 0: disproved, 1: proved, 2: gave up
+    auto prove = [&](unsigned v, unsigned c, unsigned p){
+        encode(v);
+        encode(c);
+        int x = v + 1, y = p ? -(int)(c + 1) : (int)(c + 1);
+        for(int side=0; side<2; ++side){
+            budget = min(total, fraig_query_budget);
+            unsigned start = budget;
+            solver.assume(side ? -x : x);
+            solver.assume(side ? y : -y);
+            int res = solver.solve();
+            total -= start - budget;
+            if(res == SAT){
+                add_cex();
+                return 0;
+            }
+            if(res != UNSAT)
+                return 2;
+        }
+        solver.add(-x); solver.add(y); solver.add(0);
+        solver.add(x); solver.add(-y); solver.add(0);
+        return 1;
+    };
+
+    vector<uint32_t> map(N);
+    for(unsigned v=0; v<N; ++v)
+        map[v] = 2 * v;
+    auto map_lit = [&](uint32_t lit){return map[lit >> 1] ^ (lit & 1);};
+    unsigned merged = 0;
+    for(unsigned k=0; k<A; ++k){
+        unsigned v = first_and + k;
+        aiger->and_i1[k] = map_lit(aiger->and_i1[k]);
+        aiger->and_i2[k] = map_lit(aiger->and_i2[k]);
+        if(total == 0)
+            continue;
+        vector<unsigned> &cls = classes[sig_hash(v)];
+        unsigned tries = 0;
+        bool done = false;
+        for(unsigned c : cls){
+            if(!same_sig(c, v)) continue;
+            if(tries++ == fraig_max_candidates) break;
+            unsigned p = phase(c) ^ phase(v);
+            if(prove(v, c, p) == 1){
+                map[v] = 2 * c + p;
+                ++merged;
+                done = true;
+                break;
+            }
+        }
+        if(!done)
+            cls.push_back(v);
+    }
+    if(aig_veb)
+        printf("c fraig: %u merged, %u effort left\n", merged, total);
+    if(merged == 0)
+        return 0;
+
+    map_roots(aiger, map);
+    strash_aiger(aiger);
+    return merged;
+}
+
+// dimacs literal of an aiger literal in a copy of the circuit whose node v is
+// variable base+v+1; the constant is variable 1 in every copy
+static inline int frame_lit(uint32_t lit, unsigned base){
+    unsigned v = lit >> 1;
+    int d = (v == 0) ? 1 : (int)(base + v + 1);
+    return (lit & 1) ? -d : d;
+}
+
+static void encode_frame(CaDiCaL &s, const Aiger *aiger, unsigned base){
+    for(unsigned k=0; k<aiger->num_ands; ++k){
+        int o = frame_lit(aiger->and_lit(k), base);
+        int a = frame_lit(aiger->and_i1[k], base), b = frame_lit(aiger->and_i2[k], base);
+        s.add(-o); s.add(a); s.add(0);
+        s.add(-o); s.add(b); s.add(0);
+        s.add(o); s.add(-a); s.add(-b); s.add(0);
+    }
+}
+
+unsigned scorr_aiger(Aiger *aiger){
+    unsigned I = aiger->num_inputs, L = aiger->num_latches, A = aiger->num_ands;
+    unsigned first_and = I + L + 1, N = first_and + A;
+    if(L == 0)
+        return 0;
+
+    // 64 runs from the initial states with random inputs; a node's signature
+    // hashes its values over all frames, normalized to run 0 in frame 0 being 0
+    vector<uint64_t> val(N, 0), sig(N, 0), next(L);
+    vector<uint8_t> ph(N, 0);
+    uint64_t rnd = 0x2545F4914F6CDD1Dull;
+    auto random = [&](){rnd ^= rnd << 13; rnd ^= rnd >> 7; rnd ^= rnd << 17; return rnd;};
+    auto lit_val = [&](uint32_t lit){return val[lit >> 1] ^ -(uint64_t)(lit & 1);};
+    for(unsigned i=0; i<L; ++i){
+        uint32_t d = aiger->latch_default[i];
+        val[1 + I + i] = (d == 0) ? 0 : (d == 1 ? ~0ull : random());
+    }
+    for(unsigned t=0; t<scorr_sim_frames; ++t){
+        for(unsigned i=0; i<I; ++i)
+            val[1 + i] = random();
+        for(unsigned k=0; k<A; ++k)
+            val[first_and + k] = lit_val(aiger->and_i1[k]) & lit_val(aiger->and_i2[k]);
+        for(unsigned v=0; v<N; v = (v == 0 ? 1 + I : v + 1)){
+            if(t == 0)
+                ph[v] = val[v] & 1;
+            sig[v] = (sig[v] ^ (val[v] ^ -(uint64_t)ph[v])) * 0x9E3779B97F4A7C15ull;
+        }
+        for(unsigned i=0; i<L; ++i)
+            next[i] = lit_val(aiger->latch_next[i]);
+        for(unsigned i=0; i<L; ++i)
+            val[1 + I + i] = next[i];
+    }
+
+    // candidate classes over the constant, latches and ands, smallest node first
+    vector<vector<unsigned> > classes;
+    {
+        unordered_map<uint64_t, unsigned> first;
+        for(unsigned v=0; v<N; v = (v == 0 ? 1 + I : v + 1)){
+            auto it = first.find(sig[v]);
+            if(it == first.end()){
+                first.emplace(sig[v], classes.size());
+                classes.push_back(vector<unsigned>(1, v));
+            }else
+                classes[it->second].push_back(v);
+        }
+    }
+    auto drop_singletons = [&](){
+        size_t j = 0;
+        for(size_t c=0; c<classes.size(); ++c)
+            if(classes[c].size() > 1)
+                classes[j++].swap(classes[c]);
+        classes.resize(j);
+    };
+    drop_singletons();
+    if(classes.empty())
+        return 0;
+    // member m is claimed equal to the literal rep_lit(rep, m)
+    auto rep_lit = [&](unsigned rep, unsigned m){return 2 * rep + (ph[rep] ^ ph[m]);};
+
+    // split every class by the values of the solver's model in a frame
+    auto refine = [&](CaDiCaL &s, unsigned base){
+        size_t n = classes.size();
+        for(size_t c=0; c<n; ++c){
+            vector<unsigned> keep, out;
+            // values normalized by the simulation phase, as in rep_lit
+            auto value = [&](unsigned v){return (s.val(frame_lit(2 * v, base)) > 0) ^ ph[v];};
+            bool r = value(classes[c][0]);
+            for(unsigned m : classes[c])
+                (value(m) == r ? keep : out).push_back(m);
+            classes[c].swap(keep);
+            if(out.size() > 1)
+                classes.push_back(out);
+        }
+        drop_singletons();
+    };
+
+    // one query per round: does a member differ from its representative in
+    // the frame at base (assuming all claims in frame 0 for the induction
+    // step)? Each counterexample splits at least one class.
+    unsigned budget = 0, total = scorr_total_budget;
+    auto fixpoint = [&](CaDiCaL &s, unsigned base, bool step){
+        int fresh = 2 * N + 1;
+        while(!classes.empty()){
+            int act = fresh++, hyp = step ? fresh++ : 0;
+            vector<int> miter;
+            for(auto &cls : classes){
+                for(size_t j=1; j<cls.size(); ++j){
+                    uint32_t rl = rep_lit(cls[0], cls[j]);
+                    if(step){
+                        int m0 = frame_lit(2 * cls[j], 0), r0 = frame_lit(rl, 0);
+                        s.add(-hyp); s.add(-m0); s.add(r0); s.add(0);
+                        s.add(-hyp); s.add(m0); s.add(-r0); s.add(0);
+                    }
+                    int x = fresh++, m = frame_lit(2 * cls[j], base), r = frame_lit(rl, base);
+                    s.add(-x); s.add(m); s.add(r); s.add(0);
+                    s.add(-x); s.add(-m); s.add(-r); s.add(0);
+                    miter.push_back(x);
+                }
+            }
+            s.add(-act);
+            for(int x : miter)
+                s.add(x);
+            s.add(0);
+
+            budget = min(total, scorr_query_budget);
+            unsigned start = budget;
+            if(step)
+                s.assume(hyp);
+            s.assume(act);
+            int res = s.solve();
+            total -= start - budget;
+            if(res == SAT)
+                refine(s, base);
+            s.add(-act); s.add(0);
+            if(step){s.add(-hyp); s.add(0);}
+            if(res == UNSAT)
+                return true;
+            if(res != SAT)
+                return false;
+        }
+        return true;
+    };
+
+    // base case on the initial states, then the induction step; refinement
+    // only splits classes, so what held initially keeps holding
+    bool proved;
+    {
+        CaDiCaL base;
+        base.set_terminate(&budget, budget_terminate);
+        base.add(-1); base.add(0);
+        encode_frame(base, aiger, 0);
+        for(unsigned i=0; i<L; ++i){
+            uint32_t d = aiger->latch_default[i];
+            if(d > 1) continue;
+            int l = frame_lit(aiger->latch_lit(i), 0);
+            base.add(d ? l : -l); base.add(0);
+        }
+        proved = fixpoint(base, 0, false);
+    }
+    if(proved && !classes.empty()){
+        CaDiCaL step;
+        step.set_terminate(&budget, budget_terminate);
+        step.add(-1); step.add(0);
+        encode_frame(step, aiger, 0);
+        encode_frame(step, aiger, N);
+        for(unsigned i=0; i<L; ++i){
+            int l1 = frame_lit(aiger->latch_lit(i), N), n0 = frame_lit(aiger->latch_next[i], 0);
+            step.add(-l1); step.add(n0); step.add(0);
+            step.add(l1); step.add(-n0); step.add(0);
+        }
+        proved = fixpoint(step, N, true);
+    }
+    if(!proved || classes.empty())
+        return 0;
+
+    vector<uint32_t> map(N);
+    for(unsigned v=0; v<N; ++v)
+        map[v] = 2 * v;
+    unsigned latches = 0, ands = 0;
+    for(auto &cls : classes){
+        for(size_t j=1; j<cls.size(); ++j){
+            map[cls[j]] = rep_lit(cls[0], cls[j]);
+            (cls[j] < first_and ? latches : ands)++;
+        }
+    }
+    auto map_lit = [&](uint32_t lit){return map[lit >> 1] ^ (lit & 1);};
+    for(unsigned k=0; k<A; ++k){
+        aiger->and_i1[k] = map_lit(aiger->and_i1[k]);
+        aiger->and_i2[k] = map_lit(aiger->and_i2[k]);
+    }
+    map_roots(aiger, map);
+    if(aig_veb)
+        printf("c scorr: %u latches and %u ands merged\n", latches, ands);
+    strash_aiger(aiger);
+    return latches;
+}
+
+// truth tables over 4 variables; a cut with fewer leaves does not depend on the rest
+static const uint16_t tt_vars[4] = {0xAAAA, 0xCCCC, 0xF0F0, 0xFF00};
+
+static inline uint16_t tt_swap_adjacent(uint16_t tt, unsigned i){
+    if(i == 0) return (tt & 0x9999) | ((tt & 0x2222) << 1) | ((tt & 0x4444) >> 1);
+    if(i == 1) return (tt & 0xC3C3) | ((tt & 0x0C0C) << 2) | ((tt & 0x3030) >> 2);
+    return (tt & 0xF00F) | ((tt & 0x00F0) << 4) | ((tt & 0x0F00) >> 4);
+}
+
+// smallest and-trees of all 4-input functions up to rewrite_max_cost ands,
+// by combining the trees of lower cost: f = a & b, complemented if neg.
+// Cost 0 are the constants and the literals of the variables.
+class Rewrite_library{
+public:
+    vector<uint8_t> cost;       // 255 if above rewrite_max_cost
+    vector<uint16_t> a, b;
+    vector<uint8_t> neg;
+    Rewrite_library();
+};
+
+Rewrite_library::Rewrite_library(): cost(65536, 255), a(65536), b(65536), neg(65536){
+    vector<vector<uint16_t> > level(rewrite_max_cost + 1);
+    auto put = [&](uint16_t f, unsigned c, uint16_t x, uint16_t y){
+        uint16_t g = ~f;
+        if(cost[f] <= c) return;
+        cost[f] = cost[g] = c;
+        a[f] = a[g] = x;
+        b[f] = b[g] = y;
+        neg[f] = 0;
+        neg[g] = 1;
+        level[c].push_back(f);
+    };
+    put(0, 0, 0, 0);
+    for(unsigned i=0; i<4; ++i)
+        put(tt_vars[i], 0, 0, 0);
+    for(unsigned c=1; c<=rewrite_max_cost; ++c){
+        for(unsigned i=0; 2*i<c; ++i){
+            unsigned j = c - 1 - i;
+            for(size_t x=0; x<level[i].size(); ++x){
+                for(size_t y=(i == j ? x : 0); y<level[j].size(); ++y){
+                    uint16_t f = level[i][x], g = level[j][y], nf = ~f, ng = ~g;
+                    put(f & g, c, f, g);
+                    put(f & ng, c, f, ng);
+                    put(nf & g, c, nf, g);
+                    put(nf & ng, c, nf, ng);
+                }
+            }
+        }
+    }
+}
+
+class Cut{
+public:
+    uint32_t leaves[4];     // sorted variables
+    uint8_t size;
+    uint16_t tt;            // function of the node over the leaves
+};
+
+// tt of a cut expressed over the leaves of a superset cut
+static uint16_t tt_stretch(uint16_t tt, const Cut &from, const Cut &to){
+    unsigned p = to.size;
+    for(unsigned i=from.size; i-- > 0;){
+        while(to.leaves[--p] != from.leaves[i]);
+        for(unsigned j=i; j<p; ++j)
+            tt = tt_swap_adjacent(tt, j);
+    }
+    return tt;
+}
+
+static bool cut_merge(const Cut &x, const Cut &y, Cut &res){
+    unsigned i = 0, j = 0, n = 0;
+    while(i < x.size || j < y.size){
+        uint32_t v;
+        if(j == y.size || (i < x.size && x.leaves[i] < y.leaves[j]))
+            v = x.leaves[i++];
+        else if(i == x.size || y.leaves[j] < x.leaves[i])
+            v = y.leaves[j++];
+        else{
+            v = x.leaves[i++];
+            j++;
+        }
+        if(n == 4) return false;
+        res.leaves[n++] = v;
+    }
+    res.size = n;
+    return true;
+}
+
+static bool cut_dominates(const Cut &x, const Cut &y){   // leaves of x within y
+    if(x.size > y.size) return false;
+    for(unsigned i=0; i<x.size; ++i){
+        unsigned j = 0;
+        while(j < y.size && y.leaves[j] != x.leaves[i]) ++j;
+        if(j == y.size) return false;
+    }
+    return true;
+}
+
+unsigned rewrite_aiger(Aiger *aiger){
+    static Rewrite_library lib;
+    unsigned I = aiger->num_inputs, L = aiger->num_latches, A = aiger->num_ands;
+    unsigned first_and = I + L + 1, N = first_and + A;
+    if(A == 0)
+        return 0;
+
+    // references in the original graph, for the cones a replacement frees
+    vector<unsigned> refs(N, 0), readers(N, 0);
+    for(unsigned k=0; k<A; ++k){
+        refs[aiger->and_i1[k] >> 1]++;
+        refs[aiger->and_i2[k] >> 1]++;
+    }
+    readers = refs;
+    for(uint32_t l : aiger->latch_next) refs[l >> 1]++;
+    for(unsigned l : aiger->outputs) refs[l >> 1]++;
+    for(unsigned l : aiger->bads) refs[l >> 1]++;
+    for(unsigned l : aiger->constraints) refs[l >> 1]++;
+
+    vector<vector<Cut> > cuts(N);
+    for(unsigned v=0; v<first_and; ++v){
+        Cut c;
+        c.size = (v > 0);
+        c.leaves[0] = v;
+        c.tt = (v > 0) ? tt_vars[0] : 0;
+        cuts[v].push_back(c);
+    }
+
+    // the and section is rebuilt; map[v] is the new literal of old node v
+    Strash_table table(first_and, A);
+    vector<uint32_t> map(N);
+    for(unsigned v=0; v<first_and; ++v)
+        map[v] = 2 * v;
+    auto map_lit = [&](uint32_t lit){return map[lit >> 1] ^ (lit & 1);};
+    vector<char> mark;
+    const uint32_t none = Strash_table::none;
+    uint32_t leaf_lits[4];
+    unsigned added;
+
+    // literal of function f over leaf_lits in the new graph without building
+    // it (none if it needs new ands); ands it would add are counted in added
+    // and so are existing ones in marked (to be freed) nodes
+    std::function<uint32_t(uint16_t)> dry = [&](uint16_t f) -> uint32_t{
+        if(lib.cost[f] == 0){
+            if(f == 0 || f == 0xFFFF) return f & 1;
+            for(unsigned i=0; i<4; ++i){
+                if(f == tt_vars[i]) return leaf_lits[i];
+                if(f == (uint16_t)~tt_vars[i]) return leaf_lits[i] ^ 1;
+            }
+        }
+        uint32_t l = dry(lib.a[f]), r = dry(lib.b[f]);
+        uint32_t x = (l == none || r == none) ? none : table.find(l, r);
+        if(x == none){
+            ++added;
+            return none;
+        }
+        if((x >> 1) < mark.size() && mark[x >> 1])
+            ++added;
+        return x ^ lib.neg[f];
+    };
+    std::function<uint32_t(uint16_t)> build = [&](uint16_t f) -> uint32_t{
+        if(lib.cost[f] == 0){
+            if(f == 0 || f == 0xFFFF) return f & 1;
+            for(unsigned i=0; i<4; ++i){
+                if(f == tt_vars[i]) return leaf_lits[i];
+                if(f == (uint16_t)~tt_vars[i]) return leaf_lits[i] ^ 1;
+            }
+        }
+        uint32_t l = build(lib.a[f]), r = build(lib.b[f]);
+        return table.make(l, r) ^ lib.neg[f];
+    };
+
+    vector<unsigned> cone, todo;
+    for(unsigned k=0; k<A; ++k){
+        unsigned v = first_and + k;
+        uint32_t f0 = aiger->and_i1[k], f1 = aiger->and_i2[k];
+
+        // cuts of v from the cuts of its fanins, smallest first
+        vector<Cut> &vc = cuts[v];
+        for(const Cut &x : cuts[f0 >> 1]){
+            for(const Cut &y : cuts[f1 >> 1]){
+                Cut c;
+                if(!cut_merge(x, y, c)) continue;
+                uint16_t tx = tt_stretch(x.tt, x, c), ty = tt_stretch(y.tt, y, c);
+                if(f0 & 1) tx = ~tx;
+                if(f1 & 1) ty = ~ty;
+                c.tt = tx & ty;
+                bool dominated = false;
+                for(const Cut &d : vc)
+                    if(cut_dominates(d, c)){dominated = true; break;}
+                if(!dominated)
+                    vc.push_back(c);
+            }
+        }
+        stable_sort(vc.begin(), vc.end(), [](const Cut &x, const Cut &y){return x.size < y.size;});
+        if(vc.size() > rewrite_max_cuts)
+            vc.resize(rewrite_max_cuts);
+
+        // the cut whose replacement frees the most ands more than it adds
+        int best_gain = 0;
+        const Cut *best = nullptr;
+        for(const Cut &c : vc){
+            if(c.size < 2 || lib.cost[c.tt] == 255) continue;
+            auto is_leaf = [&](unsigned u){
+                for(unsigned i=0; i<c.size; ++i)
+                    if(c.leaves[i] == u) return true;
+                return false;
+            };
+            // the ands of the cone only v uses
+            cone.clear();
+            todo.assign(1, v);
+            while(!todo.empty()){
+                unsigned x = todo.back();
+                todo.pop_back();
+                cone.push_back(x);
+                unsigned kx = x - first_and;
+                uint32_t fs[2] = {aiger->and_i1[kx] >> 1, aiger->and_i2[kx] >> 1};
+                for(uint32_t u : fs)
+                    if(u >= first_and && !is_leaf(u) && --refs[u] == 0)
+                        todo.push_back(u);
+            }
+            for(unsigned x : cone){
+                unsigned kx = x - first_and;
+                uint32_t fs[2] = {aiger->and_i1[kx] >> 1, aiger->and_i2[kx] >> 1};
+                for(uint32_t u : fs)
+                    if(u >= first_and && !is_leaf(u))
+                        ++refs[u];
+            }
+            if((int)cone.size() <= best_gain) continue;
+
+            mark.resize(first_and + table.i1.size(), 0);
+            for(size_t i=1; i<cone.size(); ++i)
+                if((map[cone[i]] >> 1) >= first_and) mark[map[cone[i]] >> 1] = 1;
+            for(unsigned i=0; i<4; ++i)
+                leaf_lits[i] = (i < c.size) ? map[c.leaves[i]] : 0;
+            added = 0;
+            dry(c.tt);
+            for(size_t i=1; i<cone.size(); ++i)
+                mark[map[cone[i]] >> 1] = 0;
+            int gain = (int)cone.size() - (int)added;
+            if(gain > best_gain){
+                best_gain = gain;
+                best = &c;
+            }
+        }
+        if(best != nullptr){
+            for(unsigned i=0; i<4; ++i)
+                leaf_lits[i] = (i < best->size) ? map[best->leaves[i]] : 0;
+            map[v] = build(best->tt);
+        }else
+            map[v] = table.make(map_lit(f0), map_lit(f1));
+
+        // the trivial cut is always there for the readers
+        Cut t;
+        t.size = 1;
+        t.leaves[0] = v;
+        t.tt = tt_vars[0];
+        vc.insert(vc.begin(), t);
+        if(vc.size() > rewrite_max_cuts)
+            vc.pop_back();
+        if(--readers[f0 >> 1] == 0 && (f0 >> 1) >= first_and) vector<Cut>().swap(cuts[f0 >> 1]);
+        if(--readers[f1 >> 1] == 0 && (f1 >> 1) >= first_and) vector<Cut>().swap(cuts[f1 >> 1]);
+    }
+
+    // keep the result only if it is smaller once the freed ands are dropped
+    vector<uint32_t> old_i1, old_i2, old_next = aiger->latch_next;
+    vector<unsigned> old_outputs = aiger->outputs, old_bads = aiger->bads, old_constraints = aiger->constraints;
+    old_i1.swap(aiger->and_i1);
+    old_i2.swap(aiger->and_i2);
+    aiger->and_i1.swap(table.i1);
+    aiger->and_i2.swap(table.i2);
+    aiger->num_ands = aiger->and_i1.size();
+    aiger->max_var = first_and - 1 + aiger->num_ands;
+    map_roots(aiger, map);
+    strash_aiger(aiger);
+    if(aiger->num_ands >= A){
+        aiger->and_i1.swap(old_i1);
+        aiger->and_i2.swap(old_i2);
+        aiger->latch_next.swap(old_next);
+        aiger->outputs.swap(old_outputs);
+        aiger->bads.swap(old_bads);
+        aiger->constraints.swap(old_constraints);
+        aiger->num_ands = A;
+        aiger->max_var = first_and - 1 + A;
+        return 0;
+    }
+    if(aig_veb)
+        printf("c rewrite: ands %u -> %u\n", A, aiger->num_ands);
+    return A - aiger->num_ands;
+}
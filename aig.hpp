@@ -4,19 +4,57 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstddef>
+#include <cstdint>
 
 using namespace std;
 
-class Aiger_and{
+class Aiger_stream;
+
+// read-only view of an aiger file for the parser. Regular files are mapped
+// into memory as a whole. Compressed files (gzip, xz) and pipes are read
+// through a window that a second thread keeps filling with decompressed
+// data, so the whole file never has to be held at once; call ensure() or
+// ensure_lines() before parsing further ahead.
+// buf[len .. len+padding) is always zero, so the parser may scan past the end
+// and load a whole vector register at any position before it.
+class Aiger_file{
 public:
-    Aiger_and(unsigned o, unsigned i1, unsigned i2);
-    unsigned o, i1, i2;
+    static const size_t padding = 64;
+    unsigned char *buf;
+    size_t len;
+    size_t map_len;     // size of the mapping, 0 if buf is on the heap
+    size_t cap;         // capacity of the heap window
+    bool eof;           // [buf, buf+len) holds everything up to the end of the file
+    Aiger_stream *stream;
+
+    Aiger_file();
+    ~Aiger_file();
+    bool open(const string &path);
+    void close();
+
+    // make at least n bytes from pos available (fewer only at the end of the
+    // file). The window may move, pos is updated accordingly.
+    void ensure(unsigned char *&pos, size_t n);
+    // make the next `lines` complete lines from pos available
+    void ensure_lines(unsigned char *&pos, size_t lines);
+
+private:
+    bool refill(unsigned char *&pos);
 };
 
-class Aiger_latches{
+// symbol table. Only the raw symbol section of the file is kept; the lines
+// are located on the first lookup and a name is decoded when it is asked for.
+class Aiger_symbols{
 public:
-    Aiger_latches(unsigned l, unsigned next, unsigned default_val);
-    unsigned l, next, default_val;
+    string raw;     // "i0 name\nl3 name\n...", exactly as in the file
+    vector<pair<unsigned long long, size_t> > index;   // (type, position) -> offset of the name in raw
+    bool indexed;
+
+    Aiger_symbols();
+    void build_index();
+    bool has(char type, unsigned pos);
+    string get(char type, unsigned pos);   // "" if there is no such symbol
 };
 
 // not support justice and fairness now;
@@ -34,12 +72,48 @@ public:
     unsigned num_fairness;      // the number of fairness.
 
     vector<unsigned> inputs, outputs, bads, constraints;
-    vector<Aiger_latches> latches;
-    vector<Aiger_and> ands;
-    map<unsigned, string> symbols;
+
+    // latches and ands as flat arrays indexed from 0, sized from the header.
+    // Their own literals follow from the index, see latch_lit() and and_lit().
+    vector<uint32_t> latch_next, latch_default;     // default: 0, 1, or the latch itself (uninitialized)
+    vector<uint32_t> and_i1, and_i2;
+
+    Aiger_symbols symbols;
     string comments;
 
     Aiger();
+    unsigned latch_lit(unsigned i) const {return 2 * (num_inputs + i + 1);}
+    unsigned and_lit(unsigned i) const {return 2 * (num_inputs + num_latches + i + 1);}
 };
 
-Aiger* load_aiger_from_file(string str);
\ No newline at end of file
+Aiger* load_aiger_from_file(string str);
+
+// combinational simplification shared by all engines: structural hashing,
+// constant propagation and folding of a&a, a&!a, then removal of the ands
+// no latch, output, bad or constraint depends on. Inputs and latches keep
+// their literals, ands are renumbered.
+void strash_aiger(Aiger *aiger);
+
+// SAT sweeping: ands (and inputs, latches, constants) that agree on random
+// bit-parallel simulation are checked for equivalence up to complement with
+// an incremental SAT solver and merged. Latches are treated as free inputs.
+// Returns the number of ands merged.
+unsigned fraig_aiger(Aiger *aiger);
+
+// signal correspondence (van Eijk): latches and ands that agree on sequential
+// simulation from the initial states are proposed as equivalent up to
+// complement, the classes are refined until they hold initially and are
+// inductive (1-step, assuming all of them), then merged into their smallest
+// member. Returns the number of latches merged.
+unsigned scorr_aiger(Aiger *aiger);
+
+// DAG-aware rewriting: for every and, the 4-input cuts are enumerated and the
+// cone above a cut is replaced by the smallest and-tree for its function when
+// that frees more ands than it adds. Returns the number of ands saved.
+unsigned rewrite_aiger(Aiger *aiger);
+
+// ternary (0/1/X) simulation from the initial state with free inputs, run to
+// a fixpoint. Latches that stay 0 or 1 hold that value in every reachable
+// state; their readers get the constant (the latch itself remains, unread).
+// Returns the number of such latches.
+unsigned remove_stuck_latches(Aiger *aiger);
\ No newline at end of file
@@ -221,4 +221,31 @@ void Internal::reset_assumptions () {
   marked_failed = true;
 }
 
+// Consecutive incremental calls often share a prefix of their assumptions,
+// e.g., in IC3 generalization where one literal is dropped per call.  The
+// decision levels of the previous call are kept as long as they agree with
+// the new assumptions, since 'decide' would redo them in the same order.
+// A pseudo decision level (assumption already implied) is kept if the new
+// assumption is still implied below it.
+
+int Internal::reusable_assumption_levels () {
+  if (!opts.ilb) return 0;
+  const int max_level = min ((size_t) level, assumptions.size ());
+  int res = 0;
+  while (res < max_level) {
+    const int lit = assumptions[res];
+    const int decision = control[res + 1].decision;
+    if (decision) {
+      if (decision != lit) break;
+    } else if (val (lit) <= 0 || var (lit).level > res) break;
+    res++;
+  }
+  if (res) {
+    stats.ilb++;
+    stats.ilblevels += res;
+    LOG ("keeping %d assumption levels", res);
+  }
+  return res;
+}
+
 }
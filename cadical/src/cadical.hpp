@@ -234,6 +234,34 @@ public:
   //
   void assume (int lit);
 
+  // Batched versions of 'add' and 'assume' for 'size' literals, which all
+  // have to be non zero.  The first adds them as a complete clause, that
+  // is as if followed by 'add (0)', the second assumes all of them.  The
+  // state checks and transitions are done once per call instead of once
+  // per literal.
+  //
+  //   require (READY)
+  //   ensure (UNKNOWN)
+  //
+  void clause (const int * lits, size_t size);
+  void assume (const int * lits, size_t size);
+
+  // Clause groups.  A new group is a fresh selector variable and the
+  // clauses added to it with 'group_clause' only hold while the selector
+  // is assumed (they are added with its negation).  Selectors must not be
+  // used in any other clause.  After 'drop_group' the clauses of the group
+  // and all learned clauses derived from them are physically deleted, and
+  // the selector variable is handed out again by a later 'new_group'.
+  // Dropped groups are collected in batches, as soon as there are more
+  // than the number of clauses divided by 'groupcollect' of them.
+  //
+  //   require (READY)
+  //   ensure (UNKNOWN)
+  //
+  int new_group ();
+  void group_clause (int group, const int * lits, size_t size);
+  void drop_group (int group);
+
   // Try to solve the current formula.  Returns
   //
   //    0 = UNSOLVED     (limit reached or interrupted through 'terminate')
@@ -250,6 +278,17 @@ public:
   //
   int solve ();
 
+  // Only propagate the assumptions without searching (conflicts on the way
+  // are still analyzed).  Returns 20 if this already shows that the
+  // assumptions are inconsistent, which then can be queried with 'failed'
+  // as after 'solve'.  Otherwise zero is returned and the assumptions stay
+  // in place for a subsequent 'solve', which also keeps their levels.
+  //
+  //   require (READY)
+  //   ensure (UNKNOWN | UNSATISFIED)
+  //
+  int propagate ();
+
   // Get value (-lit=false, lit=true) of valid non-zero literal.
   //
   //   require (SATISFIED)
@@ -266,6 +305,15 @@ public:
   //
   bool failed (int lit);
 
+  // Append all failed assumptions to 'lits' in the order in which they
+  // were assumed.  This is the same as asking 'failed' for each assumption
+  // but only needs a single call.
+  //
+  //   require (UNSATISFIED)
+  //   ensure (UNSATISFIED)
+  //
+  void core (std::vector<int> & lits);
+
   // Add call-back which is checked regularly for termination.  There can
   // only be one terminator connected.  If a second (non-zero) one is added
   // the first one is implicitly disconnected.
@@ -365,6 +413,19 @@ public:
   //
   void copy (Solver & other) const;
 
+  // Bulk variant of 'copy' for a solver that has only been given clauses
+  // (no solving or simplification yet, thus no witnesses).  The clauses
+  // are allocated and watched directly in 'other' without going through
+  // 'add', and root-level units are assigned afterwards.
+  //
+  //   require (READY)          // for 'this'
+  //   ensure (READY)           // for 'this'
+  //
+  //   other.require (CONFIGURING)
+  //   other.ensure (UNKNOWN)
+  //
+  void clone (Solver & other) const;
+
   /*----------------------------------------------------------------------*/
   // Variables are usually added and initialized implicitly whenever a
   // literal is used as an argument except for the functions 'val', 'fixed',
@@ -515,6 +576,17 @@ public:
   int64_t redundant () const;   // Number of active redundant clauses.
   int64_t irredundant () const; // Number of active irredundant clauses.
 
+  // Search effort since initialization, e.g., to attribute effort to
+  // incremental calls by taking differences.  Only propagations during
+  // search are counted (not those of probing, vivification etc.).
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  int64_t conflicts () const;
+  int64_t decisions () const;
+  int64_t propagations () const;
+
   //------------------------------------------------------------------------
   // This function executes the given number of preprocessing rounds. It is
   // similar to 'solve' with 'limits ("preprocessing", rounds)' except that
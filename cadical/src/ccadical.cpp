@@ -8,6 +8,7 @@ namespace CaDiCaL {
 struct Wrapper : Learner, Terminator {
 
   Solver * solver;
+  std::vector<int> core;
   struct {
     void * state;
     int (*function) (void *);
@@ -59,6 +60,22 @@ struct Wrapper : Learner, Terminator {
     delete solver; }
 };
 
+// Hands each traversed clause zero terminated to a 'C' call-back.
+
+struct ClauseForwarder : ClauseIterator {
+
+  void * state;
+  void (*function) (void *, const int *);
+  std::vector<int> buffer;
+
+  bool clause (const std::vector<int> & c) {
+    buffer = c;
+    buffer.push_back (0);
+    function (state, buffer.data ());
+    return true;
+  }
+};
+
 }
 
 using namespace CaDiCaL;
@@ -113,10 +130,47 @@ int ccadical_solve (CCaDiCaL * wrapper) {
   return ((Wrapper*) wrapper)->solver->solve ();
 }
 
+int ccadical_propagate (CCaDiCaL * wrapper) {
+  return ((Wrapper*) wrapper)->solver->propagate ();
+}
+
 int ccadical_simplify (CCaDiCaL * wrapper) {
   return ((Wrapper*) wrapper)->solver->simplify ();
 }
 
+void ccadical_add_clause (CCaDiCaL * wrapper, const int * lits, size_t size) {
+  ((Wrapper*) wrapper)->solver->clause (lits, size);
+}
+
+void ccadical_assume_all (CCaDiCaL * wrapper, const int * lits, size_t size) {
+  ((Wrapper*) wrapper)->solver->assume (lits, size);
+}
+
+int ccadical_new_group (CCaDiCaL * wrapper) {
+  return ((Wrapper*) wrapper)->solver->new_group ();
+}
+
+void ccadical_group_clause (CCaDiCaL * wrapper, int group,
+                            const int * lits, size_t size) {
+  ((Wrapper*) wrapper)->solver->group_clause (group, lits, size);
+}
+
+void ccadical_drop_group (CCaDiCaL * wrapper, int group) {
+  ((Wrapper*) wrapper)->solver->drop_group (group);
+}
+
+void ccadical_clone (CCaDiCaL * src, CCaDiCaL * dst) {
+  ((Wrapper*) src)->solver->clone (*((Wrapper*) dst)->solver);
+}
+
+void ccadical_traverse_clauses (CCaDiCaL * wrapper,
+  void * state, void (*clause)(void * state, const int * clause)) {
+  ClauseForwarder forwarder;
+  forwarder.state = state;
+  forwarder.function = clause;
+  ((Wrapper*) wrapper)->solver->traverse_clauses (forwarder);
+}
+
 int ccadical_val (CCaDiCaL * wrapper, int lit) {
   return ((Wrapper*) wrapper)->solver->val (lit);
 }
@@ -125,6 +179,14 @@ int ccadical_failed (CCaDiCaL * wrapper, int lit) {
   return ((Wrapper*) wrapper)->solver->failed (lit);
 }
 
+const int * ccadical_core (CCaDiCaL * ptr, size_t * size) {
+  Wrapper * wrapper = (Wrapper *) ptr;
+  wrapper->core.clear ();
+  wrapper->solver->core (wrapper->core);
+  *size = wrapper->core.size ();
+  return wrapper->core.data ();
+}
+
 void ccadical_print_statistics (CCaDiCaL * wrapper) {
   ((Wrapper*) wrapper)->solver->statistics ();
 }
@@ -141,6 +203,18 @@ int64_t ccadical_irredundant (CCaDiCaL * wrapper) {
   return ((Wrapper*) wrapper)->solver->irredundant ();
 }
 
+int64_t ccadical_conflicts (CCaDiCaL * wrapper) {
+  return ((Wrapper*) wrapper)->solver->conflicts ();
+}
+
+int64_t ccadical_decisions (CCaDiCaL * wrapper) {
+  return ((Wrapper*) wrapper)->solver->decisions ();
+}
+
+int64_t ccadical_propagations (CCaDiCaL * wrapper) {
+  return ((Wrapper*) wrapper)->solver->propagations ();
+}
+
 int ccadical_fixed (CCaDiCaL * wrapper, int lit) {
   return ((Wrapper*) wrapper)->solver->fixed (lit);
 }
@@ -173,6 +247,10 @@ void ccadical_melt (CCaDiCaL * ptr, int lit) {
   ((Wrapper*) ptr)->solver->melt (lit);
 }
 
+void ccadical_phase (CCaDiCaL * ptr, int lit) {
+  ((Wrapper*) ptr)->solver->phase (lit);
+}
+
 int ccadical_frozen (CCaDiCaL * ptr, int lit) {
   return ((Wrapper*) ptr)->solver->frozen (lit);
 }
@@ -7,6 +7,7 @@ extern "C" {
 #endif
 /*------------------------------------------------------------------------*/
 
+#include <stddef.h>
 #include <stdint.h>
 
 // C wrapper for CaDiCaL's C++ API following IPASIR.
@@ -41,12 +42,27 @@ int ccadical_get_option (CCaDiCaL *, const char * name);
 void ccadical_print_statistics (CCaDiCaL *);
 int64_t ccadical_active (CCaDiCaL *);
 int64_t ccadical_irredundant (CCaDiCaL *);
+int64_t ccadical_conflicts (CCaDiCaL *);
+int64_t ccadical_decisions (CCaDiCaL *);
+int64_t ccadical_propagations (CCaDiCaL *);
 int ccadical_fixed (CCaDiCaL *, int lit);
 void ccadical_terminate (CCaDiCaL *);
 void ccadical_freeze (CCaDiCaL *, int lit);
 int ccadical_frozen (CCaDiCaL *, int lit);
 void ccadical_melt (CCaDiCaL *, int lit);
+void ccadical_phase (CCaDiCaL *, int lit);
 int ccadical_simplify (CCaDiCaL *);
+int ccadical_propagate (CCaDiCaL *);
+const int * ccadical_core (CCaDiCaL *, size_t * size);
+void ccadical_add_clause (CCaDiCaL *, const int * lits, size_t size);
+void ccadical_assume_all (CCaDiCaL *, const int * lits, size_t size);
+int ccadical_new_group (CCaDiCaL *);
+void ccadical_group_clause (CCaDiCaL *, int group,
+  const int * lits, size_t size);
+void ccadical_drop_group (CCaDiCaL *, int group);
+void ccadical_clone (CCaDiCaL * src, CCaDiCaL * dst);
+void ccadical_traverse_clauses (CCaDiCaL *,
+  void * state, void (*clause)(void * state, const int * clause));
 
 /*------------------------------------------------------------------------*/
 
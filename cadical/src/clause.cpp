@@ -140,6 +140,53 @@ Clause * Internal::new_clause (bool red, int glue) {
   return c;
 }
 
+// Copy an irredundant clause of another solver into the prepared 'to'
+// space of the arena, renaming its literals through 'map' (indexed by
+// the variables of the other solver).  Flags are reset as in 'new_clause'.
+
+Clause * Internal::new_cloned_clause (const Clause * orig,
+                                      const vector<int> & map) {
+  assert (!orig->redundant);
+  const size_t bytes = orig->bytes ();
+  Clause * c = (Clause *) arena.copy ((const char *) orig, bytes);
+
+  stats.added.total++;
+#ifdef LOGGING
+  c->id = stats.added.total;
+#endif
+
+  c->conditioned = false;
+  c->covered = false;
+  c->enqueued = false;
+  c->frozen = false;
+  c->garbage = false;
+  c->gate = false;
+  c->hyper = false;
+  c->instantiated = false;
+  c->keep = true;
+  c->moved = false;
+  c->reason = false;
+  c->transred = false;
+  c->subsume = false;
+  c->vivified = false;
+  c->vivify = false;
+  c->used = 0;
+  c->pos = 2;
+
+  for (auto & lit : *c) lit = lit < 0 ? -map[-lit] : map[lit];
+
+  stats.current.total++;
+  stats.added.total++;
+  stats.irrbytes += bytes;
+  stats.current.irredundant++;
+  stats.added.irredundant++;
+
+  clauses.push_back (c);
+  mark_added (c);
+
+  return c;
+}
+
 /*------------------------------------------------------------------------*/
 
 void Internal::promote_clause (Clause * c, int new_glue) {
@@ -313,8 +360,53 @@ void Internal::assign_original_unit (int lit) {
 
 // New clause added through the API, e.g., while parsing a DIMACS file.
 //
+// With 'ilb' the trail is kept when original clauses are added between
+// incremental calls (so that the next call may keep assumption levels).
+// Only root-level assigned literals are removed from the clause below.  The
+// watches then have to be chosen with respect to the trail.  The literals are
+// ordered unassigned first, then true (lowest level first) and then false
+// (highest level first).  If the second watch is false, it is the highest
+// falsified literal, and unless the first literal is true below it, the trail
+// is cut back as little as possible such that the first literal becomes
+// unassigned and then is implied by the clause.  If all literals are false
+// on the same highest level, then cutting below it leaves two unassigned
+// watches.  Returns whether the first literal has to be assigned.
+
+bool Internal::watch_original_clause_on_trail () {
+  assert (level);
+  assert (clause.size () > 1);
+  auto rank = [this] (int lit) {
+    const signed char tmp = val (lit);
+    return tmp ? (tmp > 0 ? 1 : 2) : 0;
+  };
+  stable_sort (clause.begin (), clause.end (), [&] (int a, int b) {
+    const int r = rank (a), s = rank (b);
+    if (r != s) return r < s;
+    if (r == 1) return var (a).level < var (b).level;
+    if (r == 2) return var (a).level > var (b).level;
+    return false;
+  });
+  const int first = clause[0];
+  const signed char tmp = val (first);
+  if (val (clause[1]) >= 0) return false;
+  const int other = var (clause[1]).level;
+  if (!tmp) {
+    if (!opts.chrono && level > other) backtrack (other);
+    return true;
+  }
+  const int first_level = var (first).level;
+  if (tmp > 0 && first_level <= other) return false;
+  if (tmp < 0 && first_level == other) {
+    backtrack (other - 1);
+    return false;
+  }
+  backtrack (opts.chrono ? first_level - 1 : other);
+  assert (!val (first));
+  return true;
+}
+
 void Internal::add_new_original_clause () {
-  if (level) backtrack ();
+  if (level && !opts.ilb) backtrack ();
   LOG (original, "original clause");
   bool skip = false;
   if (unsat) {
@@ -331,7 +423,7 @@ void Internal::add_new_original_clause () {
         skip = true;
       } else {
         mark (lit);
-        tmp = val (lit);
+        tmp = fixed (lit);
         if (tmp < 0) {
           LOG ("removing falsified literal %d", lit);
         } else if (tmp > 0) {
@@ -357,10 +449,13 @@ void Internal::add_new_original_clause () {
         unsat = true;
       }
     } else if (size == 1) {
+      if (level) backtrack ();
       assign_original_unit (clause[0]);
     } else {
+      const bool imply = level && watch_original_clause_on_trail ();
       Clause * c = new_clause (false);
       watch_clause (c);
+      if (imply) search_assign_driving (c->literals[0], c);
     }
     if (original.size () > size) {
       external->check_learned_clause ();
@@ -410,6 +410,26 @@ bool Internal::arenaing () {
   return opts.arena && (stats.collections > 1);
 }
 
+// Delete all clauses containing one of the given selectors of dropped
+// clause groups (see 'External::collect_groups').
+
+void Internal::collect_groups (const vector<int> & selectors) {
+  if (unsat) return;
+  backtrack ();
+  LOG ("collecting %zd dropped groups", selectors.size ());
+  for (const auto lit : selectors) mark (lit);
+  for (const auto & c : clauses) {
+    if (c->garbage) continue;
+    for (const auto & lit : *c) {
+      if (!marked (lit)) continue;
+      mark_garbage (c);
+      break;
+    }
+  }
+  for (const auto lit : selectors) unmark (lit);
+  garbage_collection ();
+}
+
 void Internal::garbage_collection () {
   if (unsat) return;
   START (collect);
@@ -164,6 +164,85 @@ bool External::failed (int elit) {
   return internal->failed (ilit);
 }
 
+void External::core (vector<int> & elits) {
+  for (const auto elit : assumptions)
+    if (failed (elit))
+      elits.push_back (elit);
+}
+
+/*------------------------------------------------------------------------*/
+
+int External::new_group () {
+  reset_extended ();
+  if (free_groups.empty () && !dropped_groups.empty () &&
+      (int64_t) dropped_groups.size () * internal->opts.groupcollect >=
+        internal->stats.current.total)
+    collect_groups ();
+  int elit;
+  if (free_groups.empty ()) {
+    elit = max_var + 1;
+    init (elit);
+    freeze (elit);              // Never eliminated, so always reusable.
+    phase (-elit);              // Only true while assumed.
+  } else {
+    elit = free_groups.back ();
+    free_groups.pop_back ();
+  }
+  if ((size_t) elit >= grouptab.size ()) grouptab.resize (elit + 1, 0);
+  grouptab[elit] = 1;
+  LOG ("new group %d", elit);
+  return elit;
+}
+
+void External::drop_group (int elit) {
+  assert (live_group (elit));
+  grouptab[elit] = -1;
+  dropped_groups.push_back (elit);
+  LOG ("dropped group %d", elit);
+}
+
+// All clauses containing a dropped selector are deleted.  Since selectors
+// only occur negatively in the added clauses, every learned clause derived
+// from one of them contains the (negative) selector too.  Group clauses
+// moved to the extension stack by elimination are removed from it as well,
+// since the formula (and the resolvents) no longer contain them.  Selectors
+// which became root-level units can not be reused and are skipped.
+
+void External::collect_groups () {
+  reset_extended ();
+  vector<int> selectors;
+  for (const auto elit : dropped_groups)
+    if (!internal->fixed (e2i[elit]))   // Compacting maps all units to one.
+      selectors.push_back (e2i[elit]);
+  internal->collect_groups (selectors);
+
+  vector<char> dropped (max_var + 1, 0);
+  for (const auto elit : dropped_groups)
+    dropped[elit] = 1;
+  const auto end = extension.end ();
+  auto j = extension.begin (), i = j;
+  while (i != end) {
+    auto begin = i;
+    assert (!*i);
+    while (++i != end && *i) ;          // Witness.
+    bool group = false;
+    while (++i != end && *i)            // Clause.
+      if (dropped[abs (*i)]) group = true;
+    if (!group) j = std::copy (begin, i, j);
+  }
+  extension.resize (j - extension.begin ());
+
+  for (const auto elit : dropped_groups) {
+    grouptab[elit] = 0;
+    if (!internal->fixed (e2i[elit])) free_groups.push_back (elit);
+  }
+  LOG ("collected %zd groups, %zd free", dropped_groups.size (),
+    free_groups.size ());
+  dropped_groups.clear ();
+}
+
+/*------------------------------------------------------------------------*/
+
 void External::constrain (int elit) {
   if (constraint.size () && !constraint.back ()) {
     LOG (constraint, "replacing previous constraint");
@@ -271,6 +350,17 @@ int External::solve (bool preprocess_only) {
   return res;
 }
 
+// Unlike 'solve' the limits are not reset, as they are meant for the
+// 'solve' call following an inconclusive 'propagate_assumptions'.
+
+int External::propagate_assumptions () {
+  reset_extended ();
+  update_molten_literals ();
+  int res = internal->propagate_assumptions ();
+  check_solve_result (res);
+  return res;
+}
+
 void External::terminate () { internal->terminate (); }
 
 int External::lookahead () {
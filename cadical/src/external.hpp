@@ -78,6 +78,14 @@ struct External {
 
   vector<unsigned> frozentab; // Reference counts for frozen variables.
 
+  // Clause groups (see 'Solver::new_group').  Selectors of dropped groups
+  // wait in 'dropped_groups' until 'collect_groups' deleted their clauses
+  // and moved them to 'free_groups', from where they are reused.
+
+  vector<signed char> grouptab;       // 1 = live group, -1 = dropped
+  vector<int> free_groups;
+  vector<int> dropped_groups;
+
   // Regularly checked terminator if non-zero.  The terminator is set from
   // 'Solver::set (Terminator *)' and checked by 'Internal::terminating ()'.
 
@@ -254,6 +262,7 @@ struct External {
   void add (int elit);
   void assume (int elit);
   int solve (bool preprocess_only);
+  int propagate_assumptions ();
 
   // We call it 'ival' as abbreviation for 'val' with 'int' return type to
   // avoid bugs due to using 'signed char tmp = val (lit)', which might turn
@@ -270,6 +279,14 @@ struct External {
   }
 
   bool failed (int elit);
+  void core (vector<int> & elits);
+
+  bool live_group (int elit) const {
+    return elit > 0 && (size_t) elit < grouptab.size () && grouptab[elit] > 0;
+  }
+  int new_group ();
+  void drop_group (int elit);
+  void collect_groups ();
 
   void terminate ();
 
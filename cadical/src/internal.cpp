@@ -468,6 +468,7 @@ bool Internal::preprocess_round (int round) {
 }
 
 int Internal::preprocess () {
+  if (lim.preprocessing && level) backtrack ();
   for (int i = 0; i < lim.preprocessing; i++)
     if (!preprocess_round (i))
       break;
@@ -558,6 +559,7 @@ int Internal::local_search () {
   if (!max_var) return 0;
   if (!opts.walk) return 0;
   if (constraint.size ()) return 0;
+  if (lim.localsearch && level) backtrack ();
 
   int res = 0;
 
@@ -585,7 +587,7 @@ int Internal::solve (bool preprocess_only) {
   if (preprocess_only) LOG ("internal solving in preprocessing only mode");
   else LOG ("internal solving in full mode");
   init_report_limits ();
-  int res = already_solved ();
+  int res = already_solved (!preprocess_only);
   if (!res) res = restore_clauses ();
   if (!res) {
     init_preprocessing_limits ();
@@ -603,14 +605,45 @@ int Internal::solve (bool preprocess_only) {
   return res;
 }
 
-int Internal::already_solved () {
+// Propagates the assumptions level by level as 'decide' would, but stops
+// before the first real decision.  The assumption levels are left on the
+// trail and are kept by the next 'solve' if it has the same assumptions.
+
+int Internal::propagate_assumptions () {
+  assert (clause.empty ());
+  START (solve);
+  LOG ("internal propagating assumptions only");
+  init_report_limits ();
+  int res = already_solved (true);
+  if (!res) res = restore_clauses ();
+  if (!res && !lim.initialized) init_search_limits ();
+  while (!res) {
+         if (unsat) res = 20;
+    else if (!propagate ()) analyze ();
+    else if (iterating) iterate ();
+    else if ((size_t) level >= assumptions.size ()) break;
+    else res = decide ();
+  }
+  stats.propagated++;
+  if (res) stats.propfailed++;
+  reset_solving ();
+  STOP (solve);
+  return res;
+}
+
+int Internal::already_solved (bool reuse) {
   int res = 0;
   if (unsat || unsat_constraint) {
     LOG ("already inconsistent");
     res = 20;
   } else {
-    if (level) backtrack ();
-    if (!propagate ()) {
+    if (level) backtrack (reuse ? reusable_assumption_levels () : 0);
+    if (level && !propagate ()) {
+      LOG ("propagating kept assumption levels produces conflict");
+      conflict = 0;
+      backtrack ();
+    }
+    if (!level && !propagate ()) {
       LOG ("root level propagation produces conflict");
       learn_empty_clause ();
       res = 20;
@@ -651,6 +684,7 @@ int Internal::restore_clauses () {
     report ('*');
   } else {
     report ('+');
+    if (level) backtrack ();
     external->restore_clauses ();
     internal->report ('r');
     if (!unsat && !propagate ()) {
@@ -495,6 +495,7 @@ struct Internal {
   // these functions work on the global temporary 'clause'.
   //
   Clause * new_clause (bool red, int glue = 0);
+  Clause * new_cloned_clause (const Clause *, const vector<int> & map);
   void promote_clause (Clause *, int new_glue);
   size_t shrink_clause (Clause *, int new_size);
   void minimize_sort_clause();
@@ -517,6 +518,7 @@ struct Internal {
   void mark_garbage (Clause *);
   void assign_original_unit (int);
   void add_new_original_clause ();
+  bool watch_original_clause_on_trail ();
   Clause * new_learned_redundant_clause (int glue);
   Clause * new_hyper_binary_resolved_clause (bool red, int glue);
   Clause * new_clause_as (const Clause * orig);
@@ -646,6 +648,7 @@ struct Internal {
   void check_var_stats ();
   bool arenaing ();
   void garbage_collection ();
+  void collect_groups (const vector<int> & selectors);
 
   // Set-up occurrence list counters and containers.
   //
@@ -931,6 +934,7 @@ struct Internal {
     bool failed(int lit);     // Literal failed assumption?
     void reset_assumptions(); // Reset after 'solve' call.
     void failing();           // Prepare failed assumptions.
+    int reusable_assumption_levels (); // Levels to keep for next 'solve'.
 
     bool assumed(int lit) {   // Marked as assumption.
       Flags &f = flags(lit);
@@ -1017,7 +1021,8 @@ struct Internal {
     // is requested from 'External::simplifiy' only preprocessing is called
     // though. This is all orchestrated by the 'solve' function.
     //
-    int already_solved();
+    int already_solved(bool reuse = false);
+    int propagate_assumptions();
     int restore_clauses();
     bool preprocess_round(int round);
     int preprocess();
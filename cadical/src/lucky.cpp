@@ -271,7 +271,6 @@ int Internal::negative_horn_satisfiable () {
 /*------------------------------------------------------------------------*/
 
 int Internal::lucky_phases () {
-  assert (!level);
   require_mode (SEARCH);
   if (!opts.lucky) return 0;
 
@@ -279,6 +278,7 @@ int Internal::lucky_phases () {
   // assumptions, but this is not completely implemented nor tested yet.
   // Nothing done for constraint either.
   if (!assumptions.empty () || !constraint.empty ()) return 0;
+  assert (!level);          // Only assumption levels are kept.
 
   START (search);
   START (lucky);
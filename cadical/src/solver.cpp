@@ -557,6 +557,70 @@ void Solver::assume (int lit) {
   LOG_API_CALL_END ("assume", lit);
 }
 
+void Solver::clause (const int * lits, size_t size) {
+  REQUIRE_READY_STATE ();
+  transition_to_unknown_state ();
+  for (size_t i = 0; i < size; i++) {
+    const int lit = lits[i];
+    TRACE ("add", lit);
+    REQUIRE_VALID_LIT (lit);
+    external->add (lit);
+  }
+  TRACE ("add", 0);
+  external->add (0);
+  if (!adding_constraint) STATE (UNKNOWN);
+  LOG_API_CALL_END ("add", 0);
+}
+
+void Solver::assume (const int * lits, size_t size) {
+  REQUIRE_READY_STATE ();
+  transition_to_unknown_state ();
+  for (size_t i = 0; i < size; i++) {
+    const int lit = lits[i];
+    TRACE ("assume", lit);
+    REQUIRE_VALID_LIT (lit);
+    external->assume (lit);
+    LOG_API_CALL_END ("assume", lit);
+  }
+}
+
+int Solver::new_group () {
+  TRACE ("new_group");
+  REQUIRE_READY_STATE ();
+  transition_to_unknown_state ();
+  int res = external->new_group ();
+  LOG_API_CALL_RETURNS ("new_group", res);
+  return res;
+}
+
+void Solver::group_clause (int group, const int * lits, size_t size) {
+  REQUIRE_READY_STATE ();
+  REQUIRE (external->live_group (group), "invalid group '%d'", group);
+  transition_to_unknown_state ();
+  for (size_t i = 0; i < size; i++) {
+    const int lit = lits[i];
+    TRACE ("add", lit);
+    REQUIRE_VALID_LIT (lit);
+    REQUIRE (abs (lit) != group, "selector '%d' in group clause", group);
+    external->add (lit);
+  }
+  TRACE ("add", -group);
+  external->add (-group);
+  TRACE ("add", 0);
+  external->add (0);
+  if (!adding_constraint) STATE (UNKNOWN);
+  LOG_API_CALL_END ("add", 0);
+}
+
+void Solver::drop_group (int group) {
+  TRACE ("drop_group", group);
+  REQUIRE_READY_STATE ();
+  REQUIRE (external->live_group (group), "invalid group '%d'", group);
+  transition_to_unknown_state ();
+  external->drop_group (group);
+  LOG_API_CALL_END ("drop_group", group);
+}
+
 int Solver::lookahead () {
   TRACE ("lookahead");
   REQUIRE_VALID_OR_SOLVING_STATE ();
@@ -634,6 +698,19 @@ int Solver::solve () {
   return res;
 }
 
+int Solver::propagate () {
+  TRACE ("propagate");
+  REQUIRE_READY_STATE ();
+  transition_to_unknown_state ();
+  assert (state () & READY);
+  STATE (SOLVING);
+  const int res = external->propagate_assumptions ();
+  if (res == 20) STATE (UNSATISFIED);
+  else           STATE (UNKNOWN);
+  LOG_API_CALL_RETURNS ("propagate", res);
+  return res;
+}
+
 int Solver::simplify (int rounds) {
   TRACE ("simplify", rounds);
   REQUIRE_READY_STATE ();
@@ -670,6 +747,15 @@ bool Solver::failed (int lit) {
   return res;
 }
 
+void Solver::core (std::vector<int> & lits) {
+  TRACE ("core");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (state () == UNSATISFIED,
+    "can only get failed assumptions in unsatisfied state");
+  external->core (lits);
+  LOG_API_CALL_END ("core");
+}
+
 bool Solver::constraint_failed () {
   TRACE ("constraint_failed");
   REQUIRE_VALID_STATE ();
@@ -796,6 +882,30 @@ int64_t Solver::irredundant () const {
   return res;
 }
 
+int64_t Solver::conflicts () const {
+  TRACE ("conflicts");
+  REQUIRE_VALID_STATE ();
+  int64_t res = internal->stats.conflicts;
+  LOG_API_CALL_RETURNS ("conflicts", res);
+  return res;
+}
+
+int64_t Solver::decisions () const {
+  TRACE ("decisions");
+  REQUIRE_VALID_STATE ();
+  int64_t res = internal->stats.decisions;
+  LOG_API_CALL_RETURNS ("decisions", res);
+  return res;
+}
+
+int64_t Solver::propagations () const {
+  TRACE ("propagations");
+  REQUIRE_VALID_STATE ();
+  int64_t res = internal->stats.propagations.search;
+  LOG_API_CALL_RETURNS ("propagations", res);
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 void Solver::freeze (int lit) {
@@ -1251,6 +1361,65 @@ void Solver::copy (Solver & other) const {
   external->copy_flags (*other.external);
 }
 
+void Solver::clone (Solver & other) const {
+  REQUIRE_READY_STATE ();
+  REQUIRE (other.state () & CONFIGURING,
+    "target solver already modified");
+  REQUIRE (!internal->level && external->extension.empty (),
+    "can only clone a solver that has not been solved");
+  REQUIRE (external->grouptab.empty (),
+    "can not clone a solver with clause groups");
+  internal->opts.copy (other.internal->opts);
+  other.transition_to_unknown_state ();
+  Internal * dst = other.internal;
+  other.external->init (external->max_var);
+
+  // Map internal variables of 'this' to internal variables of 'other'.
+  vector<int> map (internal->max_var + 1, 0);
+  for (int idx = 1; idx <= internal->max_var; idx++) {
+    const int eidx = internal->i2e[idx];
+    if (!eidx) continue;
+    map[idx] = other.external->e2i[eidx];
+    const Flags & f = internal->flags (idx);
+    REQUIRE (f.status == Flags::UNUSED || f.active () || f.fixed (),
+      "can only clone a solver that has not been simplified");
+    if (f.status != Flags::UNUSED) dst->mark_active (map[idx]);
+  }
+  auto mapped = [&map] (int lit) { return lit < 0 ? -map[-lit] : map[lit]; };
+
+  if (internal->watching ())
+    for (int idx = 1; idx <= internal->max_var; idx++)
+      for (int sign = -1; sign <= 1; sign += 2) {
+        const int lit = sign * idx;
+        const size_t size = internal->watches (lit).size ();
+        if (size && map[idx]) dst->watches (mapped (lit)).reserve (size);
+      }
+
+  // All clauses go into one block of the arena of 'other'.
+  size_t bytes = 0, count = 0;
+  for (const auto & c : internal->clauses)
+    if (!c->garbage && !c->redundant) bytes += c->bytes (), count++;
+  dst->clauses.reserve (count);
+  dst->arena.prepare (bytes);
+  for (const auto & c : internal->clauses) {
+    if (c->garbage || c->redundant) continue;
+    Clause * d = dst->new_cloned_clause (c, map);
+    dst->watch_clause (d);
+  }
+  dst->arena.swap ();
+
+  // Units go last, so that their propagation sees all clauses watched.
+  if (internal->unsat) dst->unsat = true;
+  for (const auto & lit : internal->trail) {
+    if (dst->unsat) break;
+    const int other_lit = mapped (lit);
+    const signed char tmp = dst->val (other_lit);
+    if (tmp > 0) continue;
+    if (tmp < 0) { dst->learn_empty_clause (); break; }
+    dst->assign_original_unit (other_lit);
+  }
+}
+
 /*------------------------------------------------------------------------*/
 
 void Solver::section (const char * title) {
@@ -189,6 +189,10 @@ void Stats::print (Internal * internal) {
   PRT ("  reused:        %15" PRId64 "   %10.2f %%  per restart", stats.reused, percent (stats.reused, stats.restarts));
   PRT ("  reusedlevels:  %15" PRId64 "   %10.2f %%  per restart levels", stats.reusedlevels, percent (stats.reusedlevels, stats.restartlevels));
   }
+  if (all || stats.ilb)
+  PRT ("ilb:             %15" PRId64 "   %10.2f    levels kept per call", stats.ilb, relative (stats.ilblevels, stats.ilb));
+  if (all || stats.propagated)
+  PRT ("propagated:      %15" PRId64 "   %10.2f %%  refuted", stats.propagated, percent (stats.propfailed, stats.propagated));
   if (all || stats.restored) {
   PRT ("restored:        %15" PRId64 "   %10.2f %%  per weakened", stats.restored, percent (stats.restored, stats.weakened));
   PRT ("  restorations:  %15" PRId64 "   %10.2f %%  per extension", stats.restorations, percent (stats.restorations, stats.extensions));
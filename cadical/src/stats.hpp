@@ -102,6 +102,10 @@ struct Stats {
   int64_t reused;       // number of reused trails
   int64_t reusedlevels; // reused levels at restart
   int64_t reusedstable; // number of reused trails during stabilizing
+  int64_t ilb;          // calls keeping levels of previous assumptions
+  int64_t ilblevels;    // kept assumption levels
+  int64_t propagated;   // 'propagate' calls
+  int64_t propfailed;   // 'propagate' calls refuting the assumptions
   int64_t sections;     // 'section' counter
   int64_t chrono;       // chronological backtracks
   int64_t backtracks;   // number of backtracks
@@ -13,21 +13,72 @@ int main(int argc, char **argv){
     auto t_begin = system_clock::now();
 
     cout<<"c USAGE: ./modelchecker <aig-file> [<option>|<property ID>]* "<<endl;
-    Aiger *aiger = load_aiger_from_file(string(argv[1]));
     int property_index = 0;
-    bool sc = 0, acc = 0;
+    bool sc = 0, acc = 0, pg = 0, ce = 0, ss = 0, cm = 0;
+    bool strash = 1, ternary = 1, fraig = 1, scorr = 1, rewrite = 1;
+    string sat_profile;
     for (int i = 2; i < argc; ++i){
         if (string(argv[i]) == "-sc")
             sc = 1;
         else if (string(argv[i]) == "-acc")  
             acc = 1;
+        else if (string(argv[i]) == "-pg")
+            pg = 1;
+        else if (string(argv[i]) == "-ce")
+            ce = 1;
+        else if (string(argv[i]) == "-ss")
+            ss = 1;
+        else if (string(argv[i]) == "-cm")
+            cm = 1;
+        else if (string(argv[i]) == "-no-strash")
+            strash = 0;
+        else if (string(argv[i]) == "-no-ternary")
+            ternary = 0;
+        else if (string(argv[i]) == "-no-fraig")
+            fraig = 0;
+        else if (string(argv[i]) == "-no-scorr")
+            scorr = 0;
+        else if (string(argv[i]) == "-no-rewrite")
+            rewrite = 0;
+        else if (string(argv[i]) == "-no-preprocess")
+            strash = ternary = fraig = scorr = rewrite = 0;
+        else if (string(argv[i]) == "--time-limit" && i+1 < argc)
+            limits.time_limit = atof(argv[++i]);
+        else if (string(argv[i]) == "--mem-limit" && i+1 < argc)
+            limits.mem_limit = atol(argv[++i]);
+        else if (string(argv[i]) == "--sat-profile" && i+1 < argc)
+            sat_profile = argv[++i];
         else 
             property_index = (unsigned) atoi(argv[i]);
     }
+    Aiger *aiger = load_aiger_from_file(string(argv[1]));
+    try{
+        if(strash)
+            strash_aiger(aiger);
+        unsigned merged = fraig ? fraig_aiger(aiger) : 0;
+        if(merged > 0)
+            cout<<"c fraig: "<<merged<<" equivalent ands merged"<<endl;
+        unsigned stuck = ternary ? remove_stuck_latches(aiger) : 0;
+        if(stuck > 0)
+            cout<<"c ternary simulation: "<<stuck<<" constant latches removed"<<endl;
+        unsigned equiv = scorr ? scorr_aiger(aiger) : 0;
+        if(equiv > 0)
+            cout<<"c signal correspondence: "<<equiv<<" equivalent latches merged"<<endl;
+        unsigned saved = rewrite ? rewrite_aiger(aiger) : 0;
+        if(saved > 0)
+            cout<<"c rewriting: "<<saved<<" ands saved"<<endl;
+    }catch(Limit_reached &){
+        cout << "c limits reached during preprocessing" << endl;
+        cout << UNDECIDED << endl;
+        delete aiger;
+        return 1;
+    }
     int nframes = 999;
-    PDR pdr(aiger, property_index, sc, acc);
-    bool res = pdr.check();   
+    PDR pdr(aiger, property_index, sc, acc, pg, ce, ss, cm);
+    int res = pdr.check();   
     cout << res << endl;
+    if(!sat_profile.empty())
+        pdr.dump_sat_profile(sat_profile);
 
     //bmc_mixed_pdr
     // BMC bmc(aiger, property_index, 999);   
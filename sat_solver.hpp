@@ -1,14 +1,50 @@
 #pragma once
 #include "./ipasir.h"
+#include "./cadical/src/ccadical.h"
 #include "./minisat/simp/SimpSolver.h"
 #include <vector>
+#include <assert.h>
 #include <sstream>
 #include <fstream>
+#include <chrono>
+#include <sys/resource.h>
 using std::vector;
 
 #define SAT 10
 #define UNSAT 20
 #define UNKNOWN 0
+#define UNDECIDED 2     // result of a check that ran out of its limits (0 safe, 1 unsafe)
+
+// Global wall-clock and memory limits (0 for none), measured from program
+// start and on the peak resident set size. Every CaDiCaL polls them through
+// its terminator; a solve() stopped by them throws Limit_reached, which the
+// checks catch to report UNDECIDED with what they have found so far.
+class Limit_reached{};
+
+class Resource_limits{
+    unsigned polls = 0;
+public:
+    double time_limit = 0;      // seconds
+    long mem_limit = 0;         // MB
+    bool reached = false;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool active() const {return time_limit > 0 || mem_limit > 0;}
+    // the clock and rusage are only read every 256 polls
+    bool exceeded(){
+        if(reached || (++polls & 255)) return reached;
+        std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+        if(time_limit > 0 && t.count() >= time_limit)
+            reached = true;
+        struct rusage u;
+        if(mem_limit > 0 && getrusage(RUSAGE_SELF, &u) == 0 && u.ru_maxrss >= mem_limit * 1024)
+            reached = true;
+        return reached;
+    }
+    static int terminate(void *state){
+        return ((Resource_limits *)state)->exceeded();
+    }
+};
+extern Resource_limits limits;
 class SATSolver{
 public:
     virtual ~SATSolver() = default;
@@ -18,61 +54,182 @@ public:
     virtual int failed(int lit)=0;
     virtual int val(int lit)=0;
     virtual int max_var()=0;
+    // batched versions of add and assume: a clause without the terminating 0,
+    // a sequence of 0-terminated clauses, and a set of assumptions
+    virtual void add_clause(const int *lits, size_t n){
+        for(size_t i=0; i<n; ++i) add(lits[i]);
+        add(0);
+    }
+    virtual void add_cnf(const int *cnf, size_t n){
+        for(size_t i=0; i<n; ++i) add(cnf[i]);
+    }
+    virtual void assume_all(const int *lits, size_t n){
+        for(size_t i=0; i<n; ++i) assume(lits[i]);
+    }
+    void add_clause(const vector<int> &c){add_clause(c.data(), c.size());}
+    void add_cnf(const vector<int> &cnf){add_cnf(cnf.data(), cnf.size());}
+    void assume_all(const vector<int> &lits){assume_all(lits.data(), lits.size());}
     void set_clear_act(){};
     void clear_act(){};
     virtual void show_info()=0;
 };
 
-class CaDiCaL: public SATSolver{
-    void * s;
-    vector<int > cls;
+// final, so calls through a CaDiCaL * are not virtual; the batched calls go
+// to the solver once per clause / assumption set instead of once per literal
+class CaDiCaL final: public SATSolver{
+    CCaDiCaL * s;
     int nv;
+    int act;            // group of the last query, dropped by clear_act
     bool clear_flag;
+    void update_max_var(const int *lits, size_t n){
+        for(size_t i=0; i<n; ++i)
+            nv = max(nv, abs(lits[i]));
+    }
 public:
+    using SATSolver::add_clause;
+    using SATSolver::add_cnf;
+    using SATSolver::assume_all;
     CaDiCaL(){
-        s = ipasir_init();
+        s = ccadical_init();
         nv = 0;
+        act = 0;
         clear_flag = false;
+        if(limits.active())
+            set_terminate(&limits, Resource_limits::terminate);
     }
     ~CaDiCaL(){
-        ipasir_release(s);
+        ccadical_release(s);
     }
     void add(int dimacs_lit){
-        ipasir_add(s, dimacs_lit);
+        ccadical_add(s, dimacs_lit);
         nv = max(nv, abs(dimacs_lit));
-        // if(dimacs_lit == 0){
-        //     cout<<"add_cls: ";
-        //     for(int l : cls){
-        //         cout<<l<<" ";
-        //     }cout<<endl;
-        //     cls.clear();
-        // }else{
-        //     cls.push_back(dimacs_lit);
-        // }
+    }
+    void add_clause(const int *lits, size_t n){
+        ccadical_add_clause(s, lits, n);
+        update_max_var(lits, n);
+    }
+    void add_cnf(const int *cnf, size_t n){
+        for(size_t i=0, j=0; j<n; i = ++j){
+            while(cnf[j] != 0) ++j;
+            ccadical_add_clause(s, cnf+i, j-i);
+        }
+        update_max_var(cnf, n);
     }
     void assume(int assumption_lit){
-        ipasir_assume(s, assumption_lit);
+        ccadical_assume(s, assumption_lit);
+    }
+    void assume_all(const int *lits, size_t n){
+        ccadical_assume_all(s, lits, n);
     }
     int solve(){
-        return ipasir_solve(s);
+        int res = ccadical_solve(s);
+        if(res == UNKNOWN && limits.reached)
+            throw Limit_reached();
+        return res;
+    }
+    // only propagates the assumptions: UNSAT (with failed) if that refutes
+    // them, otherwise UNKNOWN and the assumptions are kept for solve()
+    int propagate(){
+        return ccadical_propagate(s);
     }
     int failed(int lit){
-        return ipasir_failed(s, lit);
+        return ccadical_failed(s, lit);
+    }
+    // all failed assumptions at once, in the order they were assumed
+    void failed_core(vector<int> &core){
+        size_t n;
+        const int *lits = ccadical_core(s, &n);
+        core.assign(lits, lits + n);
     }
     int val(int lit){
-        return ipasir_val(s, lit);
+        return ccadical_val(s, lit);
     }
     int max_var(){
         return nv;
     }
+    // bulk copy of the clauses of t into this fresh solver; t must not have
+    // been solved yet, so it is meant to be a template that is only loaded
+    void copy_from(const CaDiCaL &t){
+        assert(nv == 0);
+        ccadical_clone(t.s, s);
+        nv = t.nv;
+    }
+    void freeze(int lit){
+        ccadical_freeze(s, lit);
+    }
+    // a fresh activation variable for ordinary clauses, which group
+    // selectors must not appear in: frozen and decided false unless assumed
+    int new_var(){
+        ++nv;
+        freeze(nv);
+        ccadical_phase(s, -nv);
+        return nv;
+    }
+    void set_option(const char *name, int val){
+        ccadical_set_option(s, name, val);
+    }
+    // preprocessing only (probing, equivalent literals, elimination and
+    // subsumption); frozen variables are kept
+    int simplify(){
+        return ccadical_simplify(s);
+    }
+    long long active(){
+        return ccadical_active(s);
+    }
+    long long irredundant(){
+        return ccadical_irredundant(s);
+    }
+    // search effort so far
+    long long conflicts(){
+        return ccadical_conflicts(s);
+    }
+    long long decisions(){
+        return ccadical_decisions(s);
+    }
+    long long propagations(){
+        return ccadical_propagations(s);
+    }
+    // appends the remaining irredundant clauses 0-terminated to cnf
+    void export_clauses(vector<int> &cnf){
+        ccadical_traverse_clauses(s, &cnf, [](void *state, const int *c){
+            vector<int> &cnf = *(vector<int> *)state;
+            do cnf.push_back(*c); while(*c++);
+        });
+    }
+    // terminate(state) is polled during solve() instead of the global limits;
+    // non-zero aborts with UNKNOWN
+    void set_terminate(void *state, int (*terminate)(void *state)){
+        ccadical_set_terminate(s, state, terminate);
+    }
+    // a group is a selector literal: its clauses only hold while it is
+    // assumed, and dropping it deletes them with the clauses learned from
+    // them, after which the selector is handed out again by new_group
+    int new_group(){
+        int group = ccadical_new_group(s);
+        nv = max(nv, group);
+        return group;
+    }
+    // group of the current query, dropped by the clear_act after set_clear_act
+    int new_act(){
+        act = new_group();
+        return act;
+    }
+    void group_clause(int group, const int *lits, size_t n){
+        ccadical_group_clause(s, group, lits, n);
+        update_max_var(lits, n);
+    }
+    void group_clause(int group, const vector<int> &c){group_clause(group, c.data(), c.size());}
+    void drop_group(int group){
+        ccadical_drop_group(s, group);
+    }
     void set_clear_act(){
         clear_flag = true;
     }
+    // the group is dropped lazily, so val / failed stay valid until the
+    // next query
     void clear_act(){
-        if(clear_flag){
-            this->add(-nv);
-            this->add(0);
-        }
+        if(clear_flag)
+            drop_group(act);
         clear_flag = false;
     }
     void show_info(){};
@@ -162,7 +319,7 @@ public:
         // cout<<((Minisat::SimpSolver *)s)->nVars()<<endl;
         // cout<<((Minisat::SimpSolver *)s)->nClauses()<<endl;
 
-        ((Minisat::SimpSolver *)s)->eliminate();
+        bool ok = ((Minisat::SimpSolver *)s)->eliminate();
         
         // int max_var = 0;
         // cout<<((Minisat::SimpSolver *)s)->nVars()<<endl;
@@ -172,6 +329,11 @@ public:
         simplified_cnf.push_back(((Minisat::SimpSolver *)s)->nVars());
         simplified_cnf.push_back(-((Minisat::SimpSolver *)s)->nVars());
         simplified_cnf.push_back(0);
+        // on a conflict the clause database is left half simplified
+        if(!ok){
+            simplified_cnf.push_back(0);
+            return;
+        }
         for (Minisat::ClauseIterator c = ((Minisat::SimpSolver *)s)->clausesBegin(); 
             c != ((Minisat::SimpSolver *)s)->clausesEnd(); ++c) {
                 const Minisat::Clause & cls = *c;
@@ -0,0 +1,25 @@
+#!/bin/sh
+# Runs ./modelchecker on the regression models and checks the result line
+# (0 safe, 1 unsafe, 2 undecided).
+cd "$(dirname "$0")/.."
+fail=0
+check(){
+    model=$1; expect=$2; shift 2
+    res=$(./modelchecker tests/$model "$@" 2>&1 | grep -E '^[012]$' | tail -1)
+    if [ "$res" != "$expect" ]; then
+        echo "FAIL $model $*: got '$res', expected $expect"
+        fail=1
+    fi
+}
+
+# Without the AIG passes SatELite finds the transition relation of these
+# inconsistent; the simplified CNF has to keep the empty clause.
+check r17.aag 0
+check r17.aag 0 -no-preprocess
+check r17.aag 0 -no-preprocess -ce
+check r37.aag 0
+check r37.aag 0 -no-preprocess
+check r37.aag 0 -no-preprocess -ce
+
+[ $fail = 0 ] && echo "all tests passed"
+exit $fail